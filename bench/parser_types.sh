@@ -0,0 +1,48 @@
+#!/bin/sh
+################################################################################
+#                                     BNF2C
+#
+# This file is distributed under the 4-clause Berkeley Software Distribution
+# License. See LICENSE for details.
+################################################################################
+# Compare number of states, generated code size and generation time of each
+# parser type.
+#
+# Usage : parser_types.sh <bnf2c executable> [grammar files...]
+#         Default grammars are the benchmark & test ones
+################################################################################
+BNF2C="$1"
+if [ -z "$BNF2C" ]; then
+    echo "Usage : $0 <bnf2c executable> [grammar files...]" >&2
+    exit 1
+fi
+shift
+
+BENCH_PATH=$(dirname "$0")
+if [ $# -eq 0 ]; then
+    set -- "$BENCH_PATH"/*.bnf2c "$BENCH_PATH"/../test/*.bnf2c.*
+fi
+
+PARSER_TYPES=${PARSER_TYPES:-"LR0 LR1 LALR1 LALR1-DP PGM"}
+TMP_PATH=$(mktemp -d)
+trap 'rm -rf "$TMP_PATH"' EXIT
+
+printf "%-28s %-9s %8s %12s %8s\n" "Grammar" "Type" "States" "Code (bytes)" "Time (s)"
+for grammar in "$@"; do
+    for parserType in $PARSER_TYPES; do
+        start=$(date +%s.%N)
+        "$BNF2C" -T "$parserType" -d 1 -o "$TMP_PATH/code" "$grammar" 2> "$TMP_PATH/debug"
+        status=$?
+        end=$(date +%s.%N)
+
+        if [ $status -eq 0 ]; then
+            states=$(grep -c "^Set " "$TMP_PATH/debug")
+            codeSize=$(wc -c < "$TMP_PATH/code")
+        else
+            states="error"
+            codeSize="-"
+        fi
+
+        printf "%-28s %-9s %8s %12s %8.3f\n" "$(basename "$grammar")" "$parserType" "$states" "$codeSize" "$(awk "BEGIN { print $end - $start }")"
+    done
+done
@@ -35,18 +35,39 @@ find_package_handle_standard_args(BNF2C
     REQUIRED_VARS BNF2C_EXECUTABLE
 )
 
+# add_parser(<source>... [SUFFIX <suffix>] [OPTIONS <bnf2c options>...] [DEPENDS <files>...])
+# Sources are taken from the source directory, or else from the binary one
+# (once generated by add_lexer). The suffix replaces ".bnf2c" in output files
+# names, so that a parser can be generated several times with different options.
+# Files read by bnf2c (a profile for instance) are given as dependencies
+include(CMakeParseArguments)
 function(add_parser)
-    foreach(PARSER_SRC ${ARGV})
-        string(REPLACE ".bnf2c" "" OUTPUT_FILE ${PARSER_SRC})
+    cmake_parse_arguments(PARSER "" "SUFFIX" "OPTIONS;DEPENDS" ${ARGV})
+
+    foreach(PARSER_SRC ${PARSER_UNPARSED_ARGUMENTS})
+        string(REPLACE ".bnf2c" "${PARSER_SUFFIX}" OUTPUT_FILE ${PARSER_SRC})
+        if(EXISTS ${CMAKE_CURRENT_SOURCE_DIR}/${PARSER_SRC})
+            set(INPUT_FILE ${CMAKE_CURRENT_SOURCE_DIR}/${PARSER_SRC})
+            set(SOURCE_TARGET "")
+        else()
+            # A generated source (a lexer output) may be shared by several parsers :
+            # it is built once by its own target, not concurrently by each of them
+            set(INPUT_FILE ${CMAKE_CURRENT_BINARY_DIR}/${PARSER_SRC})
+            string(MAKE_C_IDENTIFIER "source_${PARSER_SRC}" SOURCE_TARGET)
+            if(NOT TARGET ${SOURCE_TARGET})
+                add_custom_target(${SOURCE_TARGET} DEPENDS ${INPUT_FILE})
+            endif()
+        endif()
 
         add_custom_command(
             OUTPUT ${OUTPUT_FILE}
-            COMMAND ${BNF2C_EXECUTABLE} ${CMAKE_CURRENT_BINARY_DIR}/${PARSER_SRC} > ${OUTPUT_FILE}
+            COMMAND ${BNF2C_EXECUTABLE} ${PARSER_OPTIONS} ${INPUT_FILE} > ${OUTPUT_FILE}
             DEPENDS ${BNF2C_EXECUTABLE}
-            DEPENDS ${PARSER_SRC}
+            DEPENDS ${PARSER_SRC} ${SOURCE_TARGET} ${PARSER_DEPENDS}
             COMMENT "Building parser source ${OUTPUT_FILE}"
         )
     endforeach()
 
-    include_directories(${CMAKE_CURRENT_SOURCE_DIR})
+    # Generated parsers may be headers
+    include_directories(${CMAKE_CURRENT_SOURCE_DIR} ${CMAKE_CURRENT_BINARY_DIR})
 endfunction(add_parser)
@@ -9,11 +9,88 @@
 #include <sstream>
 #include <iostream>
 #include <stdexcept>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+////////////////////////////////////////////////////////////////////////////////
+OutputSink::OutputSink(void)
+: m_buffer(BUFFER_SIZE)
+{
+    setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OutputSink::~OutputSink(void)
+{
+    flushBuffer();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OutputSink::setDestination(std::streambuf * destination)
+{
+    flushBuffer();
+    m_destination = destination;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OutputSink::flushBuffer(void)
+{
+    if((m_destination != nullptr) && (pptr() != pbase()))
+    {
+        m_destination->sputn(pbase(), pptr() - pbase());
+        m_destination->pubsync();
+    }
+
+    setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+OutputSink::int_type OutputSink::overflow(int_type c)
+{
+    flushBuffer();
+    if(!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+
+    return traits_type::not_eof(c);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::streamsize OutputSink::xsputn(const char * s, std::streamsize n)
+{
+    if(n > (epptr() - pptr()))
+    {
+        flushBuffer();
+
+        // Big chunks (copied input text) are written directly
+        if(n >= static_cast<std::streamsize>(m_buffer.size()))
+            return (m_destination != nullptr) ? m_destination->sputn(s, n) : n;
+    }
+
+    std::memcpy(pptr(), s, n);
+    pbump(static_cast<int>(n));
+    return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int OutputSink::sync(void)
+{
+    // Lines ends don't flush, the buffer is written when full
+    return 0;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 Streams::Streams(const std::string & inputFileName, const std::string & outputFileName)
+: m_outputStream(&m_outputSink)
 {
-    if(!inputFileName.empty())
+    const bool isMapped = !inputFileName.empty() && mapInputFile(inputFileName);
+    if(!inputFileName.empty() && !isMapped)
     {
         m_inputFileStream.open(inputFileName);
 
@@ -28,23 +105,61 @@ Streams::Streams(const std::string & inputFileName, const std::string & outputFi
         if(m_outputFileStream.fail())
             throw std::runtime_error("Unable to open output file \"" + outputFileName + "\"");
     }
+
+    m_outputSink.setDestination(m_outputFileStream.is_open() ? m_outputFileStream.rdbuf() : std::cout.rdbuf());
+
+    if(!isMapped)
+        readInput(m_inputFileStream.is_open() ? m_inputFileStream : std::cin);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Streams::~Streams(void)
+{
+    m_outputSink.flushBuffer();
+
+    if(m_mappedInput != nullptr)
+        ::munmap(const_cast<char *>(m_mappedInput), m_mappedSize);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-std::istream & Streams::inputStream(void)
+const char * Streams::inputBuffer(void) const
 {
-    if(m_inputFileStream.is_open())
-        return m_inputFileStream;
-    else
-        return std::cin;
+    return (m_mappedInput != nullptr) ? m_mappedInput : m_inputBuffer.c_str();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 std::ostream & Streams::outputStream(void)
 {
-    if(m_outputFileStream.is_open())
-        return m_outputFileStream;
-    else
-        return std::cout;
+    return m_outputStream;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool Streams::mapInputFile(const std::string & inputFileName)
+{
+    const int fd = ::open(inputFileName.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+
+    // The mapping is nul terminated by the zeros padding its last page, unless the file fills it
+    struct stat status;
+    if((::fstat(fd, &status) == 0) && S_ISREG(status.st_mode) && (status.st_size > 0) && ((status.st_size % ::sysconf(_SC_PAGESIZE)) != 0))
+    {
+        void * mapping = ::mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(mapping != MAP_FAILED)
+        {
+            m_mappedInput = static_cast<const char *>(mapping);
+            m_mappedSize  = status.st_size;
+        }
+    }
+
+    ::close(fd);
+    return (m_mappedInput != nullptr);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void Streams::readInput(std::istream & is)
+{
+    char chunk[64 * 1024];
+    while(is.read(chunk, sizeof(chunk)) || (is.gcount() > 0))
+        m_inputBuffer.append(chunk, is.gcount());
+}
@@ -10,18 +10,56 @@
 #include <istream>
 #include <ostream>
 #include <fstream>
+#include <streambuf>
+#include <vector>
+
+// Output buffer written to its destination by big chunks only : syncs (std::endl,
+// std::flush) don't write it, the buffer being flushed when full or destroyed
+class OutputSink : public std::streambuf
+{
+    public :
+        static const size_t BUFFER_SIZE = 1024 * 1024;
+
+    public :
+        OutputSink(void);
+        ~OutputSink(void);
+
+        void setDestination(std::streambuf * destination);
+        void flushBuffer(void);
+
+    protected :
+        int_type        overflow(int_type c) override;
+        std::streamsize xsputn(const char * s, std::streamsize n) override;
+        int             sync(void) override;
+
+    private :
+        std::streambuf *  m_destination = nullptr;
+        std::vector<char> m_buffer;
+};
 
 class Streams
 {
     public :
         Streams(const std::string & inputFileName, const std::string & outputFileName);
+        ~Streams(void);
+
+        // Whole input, nul terminated : the memory mapped input file, or a copy of the standard input
+        const char * inputBuffer(void) const;
 
-        std::istream & inputStream(void);
         std::ostream & outputStream(void);
 
     protected :
+        bool mapInputFile(const std::string & inputFileName);
+        void readInput(std::istream & is);
+
         std::ifstream m_inputFileStream;
         std::ofstream m_outputFileStream;
+        OutputSink    m_outputSink;
+        std::ostream  m_outputStream;
+
+        const char *  m_mappedInput = nullptr;
+        size_t        m_mappedSize  = 0;
+        std::string   m_inputBuffer;
 };
 
 #endif /* STREAMS_H */
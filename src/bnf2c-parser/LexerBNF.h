@@ -17,7 +17,7 @@ class LexerBNF
     public :
         static const std::string BNF2C_TOKEN;
 
-        LexerBNF(const std::string & input, std::ostream & output);
+        LexerBNF(const char * input, std::ostream & output);
 
         bool moveToNextBnf2cBlock(void);
 
@@ -34,6 +34,7 @@ class LexerBNF
 
         LexerState m_state;
         LexerState m_lastState;
+        const char * m_inputEnd;
 
         std::ostream &  m_output;
 };
@@ -8,6 +8,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <cstring>
 
 /*!re2c
    re2c:define:YYCTYPE = "unsigned char";
@@ -21,8 +22,8 @@
 const std::string LexerBNF::BNF2C_TOKEN("/*!bnf2c");
 
 ////////////////////////////////////////////////////////////////////////////////
-LexerBNF::LexerBNF(const std::string & input, std::ostream & output)
-: m_state(input.c_str()), m_lastState(input.c_str()), m_output(output)
+LexerBNF::LexerBNF(const char * input, std::ostream & output)
+: m_state(input), m_lastState(input), m_inputEnd(input + std::strlen(input)), m_output(output)
 {
 }
 
@@ -31,25 +32,21 @@ bool LexerBNF::moveToNextBnf2cBlock(void)
 {
     const char * start = m_state.input;
 
-    while((m_state.input[0] != '\0') && (LexerBNF::BNF2C_TOKEN.compare(0, std::string::npos, m_state.input, LexerBNF::BNF2C_TOKEN.size()) != 0))
+    // Only '/' may start a block, they are looked for with (vectorized) memchr
+    const char * block = start;
+    while((block = static_cast<const char *>(std::memchr(block, '/', m_inputEnd - block))) != nullptr)
     {
-        if(m_state.input[0] == '\n')
-        {
-            if(m_state.input[1] == '\r')
-                m_state.input++;
-
-            m_state.addNewline(m_state.input + 1);
-        }
-        else if(m_state.input[0] == '\r')
-        {
-            if(m_state.input[1] == '\n')
-                m_state.input++;
-
-            m_state.addNewline(m_state.input + 1);
-        }
+        if(std::strncmp(block, LexerBNF::BNF2C_TOKEN.c_str(), LexerBNF::BNF2C_TOKEN.size()) == 0)
+            break;
 
-        m_state.input++;
+        block++;
     }
+    if(block == nullptr)
+        block = m_inputEnd;
+
+    // Skipped lines are counted in bulk
+    m_state.addNewlines(block);
+    m_state.input = block;
 
     m_output.write(start, m_state.input - start);
     if(m_state.input[0] != '\0')
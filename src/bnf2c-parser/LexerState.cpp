@@ -6,6 +6,8 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "LexerState.h"
 
+#include <cstring>
+
 LexerState::LexerState(const char * input)
 : input(input), lastNewLine(input), line(1), tabs(0)
 { }
@@ -45,6 +47,28 @@ void LexerState::addNewline(const char * start)
     tabs = 0;
 }
 
+void LexerState::addNewlines(const char * end)
+{
+    // Unix-style new lines only, found with (vectorized) memchr
+    if(std::memchr(input, '\r', end - input) == nullptr)
+    {
+        for(const char * newline = input; (newline = static_cast<const char *>(std::memchr(newline, '\n', end - newline))) != nullptr; newline++)
+            addNewline(newline + 1);
+
+        return;
+    }
+
+    // "\n\r", "\r\n", "\n" & "\r" new lines, the cursor being left untouched
+    for(const char * current = input; current < end; current++)
+    {
+        if(((current[0] == '\n') && (current[1] == '\r')) || ((current[0] == '\r') && (current[1] == '\n')))
+            current++;
+
+        if((current[0] == '\n') || (current[0] == '\r'))
+            addNewline(current + 1);
+    }
+}
+
 void LexerState::addTabulation(void)
 {
     tabs++;
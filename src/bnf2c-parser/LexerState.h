@@ -27,6 +27,9 @@ struct LexerState
     std::string getCurrentLine(void) const;
 
     void addNewline(const char * start = nullptr);
+
+    // New lines from the current input up to "end", input being left untouched
+    void addNewlines(const char * end);
     void addTabulation(void);
 };
 
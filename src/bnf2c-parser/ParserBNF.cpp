@@ -31,6 +31,7 @@ ParserBNF::ParserBNF(LexerBNF & lexer, Grammar & grammar)
     m_stringParams["parser:state-type"]            = &m_options.stateType;
     m_stringParams["parser:top-state"]             = &m_options.topState;
     m_parameterizedStringParams["parser:pop-state"] = &m_options.popState;
+    m_parameterizedStringParams["parser:push-state"] = &m_options.pushState;
     m_stringParams["parser:error-state"]           = &m_options.errorState;
     m_stringParams["parser:accept-state"]          = &m_options.acceptState;
 
@@ -45,6 +46,8 @@ ParserBNF::ParserBNF(LexerBNF & lexer, Grammar & grammar)
     // Lexer options
     m_stringParams["lexer:token-type"]          = &m_options.tokenType;
     m_stringParams["lexer:shift-token"]         = &m_options.shiftToken;
+    m_stringParams["lexer:current-token"]       = &m_options.currentToken;
+    m_stringParams["lexer:lexer-type"]          = &m_options.lexerType;
     m_stringParams["lexer:token-prefix"]        = &m_options.tokenPrefix;
     m_parameterizedStringParams["lexer:get-type-of-token"] = &m_options.getTypeOfToken;
     m_stringParams["lexer:end-of-input-token"]  = &m_options.endOfInputToken;
@@ -54,9 +57,16 @@ ParserBNF::ParserBNF(LexerBNF & lexer, Grammar & grammar)
     m_stringParams["output:parse-function"]     = &m_options.parseFunctionName;
     m_stringParams["output:branch-function"]    = &m_options.branchFunctionName;
     m_stringParams["output:throwed-exceptions"] = &m_options.throwedExceptions;
+    m_stringParams["output:parser-struct"]      = &m_options.parserStruct;
+    m_stringParams["output:instrument"]         = &m_options.instrumentFile;
+    m_stringParams["output:profile"]            = &m_options.profileFile;
 
     m_boolParams  ["generator:default-switch"]  = &m_options.defaultSwitchStatement;
     m_boolParams  ["generator:branch-table"]    = &m_options.useTableForBranches;
+    m_boolParams  ["generator:compressed-tables"] = &m_options.useCompressedTables;
+    m_boolParams  ["generator:computed-goto"]   = &m_options.useComputedGotos;
+    m_boolParams  ["generator:constexpr-tables"] = &m_options.useConstexprTables;
+    m_boolParams  ["generator:fuse-reduces"]    = &m_options.fuseReduces;
 
     // Internal options
     m_stringParams["indent:string"]             = &m_options.indent.string;
@@ -76,8 +86,7 @@ void ParserBNF::parseBnf2cBlock(void)
             case TokenType::INTERMEDIATE :
             {
                 m_lastIntermediate = m_token.toIntermediate();
-                Rule rule(m_lastIntermediate);
-                m_grammar.intermediates.insert(m_lastIntermediate);
+                Rule rule(m_grammar.addIntermediate(m_lastIntermediate));
 
                 m_token = m_lexer.nextToken();
                 if(m_token.getType() != TokenType::AFFECTATION)
@@ -92,8 +101,7 @@ void ParserBNF::parseBnf2cBlock(void)
             // New alternative to the current parsing rule
             case TokenType::OR :
             {
-                Rule rule(m_lastIntermediate);
-                m_grammar.intermediates.insert(m_lastIntermediate);
+                Rule rule(m_grammar.addIntermediate(m_lastIntermediate));
 
                 parseRule(rule);
 
@@ -232,6 +240,10 @@ void ParserBNF::parseParameter(void)
         if(m_options.popState.toString().find(Vars::NB_STATES) == std::string::npos)
             ADD_PARSING_ERROR("Parameter \"" << paramName << "\" must contains the keyword " << Vars::NB_STATES << " to be replaced by the number of states to be poped");
 
+        // Check "pushState" special parameter
+        if(m_options.pushState.toString().find(Vars::STATE) == std::string::npos)
+            ADD_PARSING_ERROR("Parameter \"" << paramName << "\" must contains the keyword " << Vars::STATE << " to be replaced by the state to be pushed");
+
         return;
     }
 
@@ -5,10 +5,12 @@
 // License. See LICENSE for details.
 ////////////////////////////////////////////////////////////////////////////////
 #include "Options.h"
+#include "utils/Parallel.h"
 
 #include <sstream>
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 ////////////////////////////////////////////////////////////////////////////////
 Indenter & Indenter::operator ++(int)
@@ -47,10 +49,16 @@ bool Indenter::operator !=(const Indenter & indenter) const
 ////////////////////////////////////////////////////////////////////////////////
 std::ostream & operator <<(std::ostream & os, const Indenter & indenter)
 {
-    for(unsigned int i = 0; i < (indenter.top + indenter.indent); i++)
-        os << indenter.string;
+    const size_t size = (indenter.top + indenter.indent) * indenter.string.size();
+    if((indenter.prefix.size() < size) || (indenter.prefixString != indenter.string))
+    {
+        indenter.prefix.clear();
+        for(unsigned int i = 0; i < (indenter.top + indenter.indent); i++)
+            indenter.prefix += indenter.string;
+        indenter.prefixString = indenter.string;
+    }
 
-    return os;
+    return os.write(indenter.prefix.data(), size);
 }
 
 
@@ -72,12 +80,14 @@ const struct option Options::OPTIONS [] = {
     { "help",                   no_argument,       nullptr, 'h'},
     { "version",                no_argument,       nullptr, 'v'},
     { "debug",                  required_argument, nullptr, 'd'},
+    { "jobs",                   required_argument, nullptr, 'J'},
 
     // Parser options
     { "parser-type",            required_argument, nullptr, 'T'},
     { "state-type",             required_argument, nullptr, 's'},
     { "top-state-code",         required_argument, nullptr, 't'},
     { "pop-state-code",         required_argument, nullptr, 'p'},
+    { "push-state-code",        required_argument, nullptr, 'P'},
     { "error-state",            required_argument, nullptr, 'e'},
     { "accept-state",           required_argument, nullptr, 'a'},
 
@@ -92,6 +102,8 @@ const struct option Options::OPTIONS [] = {
     // Lexer options
     { "token-type",             required_argument, nullptr, 'y'},
     { "shift-token-code",       required_argument, nullptr, 'c'},
+    { "current-token-code",     required_argument, nullptr, 'K'},
+    { "lexer-type",             required_argument, nullptr, 'L'},
     { "token-prefix",           required_argument, nullptr, 'r'},
     { "get-type-of-token-code", required_argument, nullptr, 'l'},
     { "end-of-input-token",     required_argument, nullptr, 'f'},
@@ -101,9 +113,16 @@ const struct option Options::OPTIONS [] = {
     { "parse-function",         required_argument, nullptr, 'n'},
     { "branch-function",        required_argument, nullptr, 'b'},
     { "throwed-exceptions",     required_argument, nullptr, 'x'},
+    { "parser-struct",          required_argument, nullptr, 'S'},
+    { "instrument",             required_argument, nullptr, 'I'},
+    { "profile",                required_argument, nullptr, 'R'},
 
     { "default-switch",         no_argument,       nullptr, 'w'},
     { "use-table-for-branches", no_argument,       nullptr, 'u'},
+    { "compressed-tables",      no_argument,       nullptr, 'C'},
+    { "computed-goto",          no_argument,       nullptr, 'G'},
+    { "constexpr-tables",       no_argument,       nullptr, 'X'},
+    { "fuse-reduces",           no_argument,       nullptr, 'F'},
     { "output",                 required_argument, nullptr, 'o'},
     { nullptr,                  no_argument,       nullptr,  0}
 };
@@ -115,11 +134,14 @@ const std::vector<std::string> Options::OPTIONS_TEXT [] = {
           "  - 1 : Debug generator",
           "  - 2 : Debug parser",
           "  - 3 : Debug lexer" },
+        { "Number of threads generating parser states & their code (default one per processor)" },
 
-        { "Type of generated parser : LR0, LR1 or LALR1" },
+        { "Type of generated parser : LR0, LR1, LALR1, LALR1-DP (LALR1 lookaheads computed with DeRemer & Pennello's method)",
+          "or PGM (LR1 with states merged by Pager's General Method)" },
         { "Type used for generated states" },
         { "Code used to get the state on top of the stack" },
         { "Code used to pop states from the stack" },
+        { "Code used to push a state on the stack (computed goto parser only)" },
         { "State number used to specify an error" },
         { "State number used when parsing is done and the input is accepted" },
         { "Type regrouping intermediate and token values" },
@@ -132,6 +154,8 @@ const std::vector<std::string> Options::OPTIONS_TEXT [] = {
 
         { "Type used for tokens" },
         { "Code used to move lexer to the next token" },
+        { "Code used to get the current token (computed goto parser or parser struct only)" },
+        { "Type of the lexer given to the parse function of a parser struct (default no lexer)" },
         { "Prefix of token" },
         { "Code used to get the type of token" },
         { "Name of the token use to specify end of input stream" },
@@ -140,16 +164,29 @@ const std::vector<std::string> Options::OPTIONS_TEXT [] = {
         { "Name of the generated parse function" },
         { "Name of the generated branch function" },
         { "Names of the exceptions throwed by generated functions (default no exceptions throwed)" },
+        { "Generate a parser struct owning its states & values stacks, with a parse function looping over all tokens",
+          "(default stacks handled by user code, see top / pop / push codes)" },
+        { "Generate a parser counting the terminals each state is entered with, hits being appended to the given",
+          "profile file at exit (<stdio.h> & <stdlib.h> needed, not used with compressed tables)" },
+        { "Order states & cases by the hits of the given profile file, hinting cases as likely or unlikely",
+          "(BNF2C_LIKELY & BNF2C_UNLIKELY macros, C++20 attributes by default)" },
         { "Generate a default statement in switch / case (default no default case)" },
         { "Use table instead of a function for branches (default use function)" },
+        { "Generate compressed ACTION & GOTO tables looked up by the parse function (default use switch / case)" },
+        { "Generate a parse function looping over all tokens, jumping from state to state with GNU C computed gotos",
+          "(default one call per action, not used with compressed tables)" },
+        { "Generate compressed tables as C++17 constexpr std::array (implies compressed tables),",
+          "a parser struct becoming a template on its lexer & value types" },
+        { "Chain reduces whose goto is statically known in a single action, with their states pops coalesced",
+          "(default one reduce per action, not used with compressed tables)" },
 
         { "Specify the name of the output file (default to stdout)" }
 };
 
-#define NB_OPTIONS_COMMON    3
-#define NB_OPTIONS_PARSER    13
-#define NB_OPTIONS_LEXER     5
-#define NB_OPTIONS_GENERATOR 6
+#define NB_OPTIONS_COMMON    4
+#define NB_OPTIONS_PARSER    14
+#define NB_OPTIONS_LEXER     7
+#define NB_OPTIONS_GENERATOR 13
 #define NB_OPTIONS_FILE      1
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -192,6 +229,7 @@ void Options::parseArguments(int argc, char ** argv)
             case 's' : stateType.assign(optarg);           break;
             case 't' : topState.assign(optarg);            break;
             case 'p' : popState = optarg;                  break;
+            case 'P' : pushState = optarg;                 break;
             case 'e' : errorState.assign(optarg);          break;
             case 'a' : acceptState.assign(optarg);         break;
 
@@ -205,6 +243,8 @@ void Options::parseArguments(int argc, char ** argv)
 
             case 'y' : tokenType.assign(optarg);           break;
             case 'c' : shiftToken.assign(optarg);          break;
+            case 'K' : currentToken.assign(optarg);        break;
+            case 'L' : lexerType.assign(optarg);           break;
             case 'r' : tokenPrefix.assign(optarg);         break;
             case 'l' : getTypeOfToken = optarg;            break;
             case 'f' : endOfInputToken.assign(optarg);     break;
@@ -213,9 +253,16 @@ void Options::parseArguments(int argc, char ** argv)
             case 'n' : parseFunctionName.assign(optarg);   break;
             case 'b' : branchFunctionName.assign(optarg);  break;
             case 'x' : throwedExceptions.assign(optarg);   break;
+            case 'S' : parserStruct.assign(optarg);        break;
+            case 'I' : instrumentFile.assign(optarg);      break;
+            case 'R' : profileFile.assign(optarg);         break;
 
             case 'w' : defaultSwitchStatement = true;      break;
             case 'u' : useTableForBranches    = true;      break;
+            case 'C' : useCompressedTables    = true;      break;
+            case 'G' : useComputedGotos       = true;      break;
+            case 'X' : useConstexprTables     = true;      break;
+            case 'F' : fuseReduces            = true;      break;
 
             case 'o' : outputFileName.assign(optarg);    break;
 
@@ -227,6 +274,18 @@ void Options::parseArguments(int argc, char ** argv)
                 debugLevel = (DebugLevel) debugLevelInt;
                 break;
             }
+            case 'J' :
+            {
+                // Only a positive number (or 0 for all processors) is accepted
+                long long nbJobsInt = -1;
+                std::istringstream iss(optarg);
+                iss >> nbJobsInt;
+                if(iss.fail() || !iss.eof() || (nbJobsInt < 0))
+                    ADD_COMMAND_LINE_PARSING_ERROR(1, "Invalid number of jobs '" << optarg << "'");
+                else
+                    nbJobs = std::min<long long>(nbJobsInt, MAX_WORKERS);
+                break;
+            }
             case 'v' :
                 std::cout << "bnf2c version " << Options::VERSION << std::endl;
                 std::cout << "Copyright © 2013 - 2018, Jérôme DUMESNIL" << std::endl;
@@ -303,6 +362,7 @@ Options & Options::operator <<(const Options & options)
     SET_OPTION_IF_NOT_DEFAULT(stateType);
     SET_OPTION_IF_NOT_DEFAULT(topState);
     SET_OPTION_IF_NOT_DEFAULT(popState);
+    SET_OPTION_IF_NOT_DEFAULT(pushState);
     SET_OPTION_IF_NOT_DEFAULT(errorState);
     SET_OPTION_IF_NOT_DEFAULT(acceptState);
 
@@ -317,6 +377,8 @@ Options & Options::operator <<(const Options & options)
     // Lexer options
     SET_OPTION_IF_NOT_DEFAULT(tokenType);
     SET_OPTION_IF_NOT_DEFAULT(shiftToken);
+    SET_OPTION_IF_NOT_DEFAULT(currentToken);
+    SET_OPTION_IF_NOT_DEFAULT(lexerType);
     SET_OPTION_IF_NOT_DEFAULT(tokenPrefix);
     SET_OPTION_IF_NOT_DEFAULT(getTypeOfToken);
     SET_OPTION_IF_NOT_DEFAULT(endOfInputToken);
@@ -326,11 +388,19 @@ Options & Options::operator <<(const Options & options)
     SET_OPTION_IF_NOT_DEFAULT(parseFunctionName);
     SET_OPTION_IF_NOT_DEFAULT(branchFunctionName);
     SET_OPTION_IF_NOT_DEFAULT(throwedExceptions);
+    SET_OPTION_IF_NOT_DEFAULT(parserStruct);
+    SET_OPTION_IF_NOT_DEFAULT(instrumentFile);
+    SET_OPTION_IF_NOT_DEFAULT(profileFile);
     SET_OPTION_IF_NOT_DEFAULT(defaultSwitchStatement);
     SET_OPTION_IF_NOT_DEFAULT(useTableForBranches);
+    SET_OPTION_IF_NOT_DEFAULT(useCompressedTables);
+    SET_OPTION_IF_NOT_DEFAULT(useComputedGotos);
+    SET_OPTION_IF_NOT_DEFAULT(useConstexprTables);
+    SET_OPTION_IF_NOT_DEFAULT(fuseReduces);
     SET_OPTION_IF_NOT_DEFAULT(tokenName);
     SET_OPTION_IF_NOT_DEFAULT(intermediateName);
     SET_OPTION_IF_NOT_DEFAULT(debugLevel);
+    SET_OPTION_IF_NOT_DEFAULT(nbJobs);
 
     SET_OPTION_IF_NOT_DEFAULT(indent);
     SET_OPTION_IF_NOT_DEFAULT(inputFileName);
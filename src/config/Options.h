@@ -20,6 +20,10 @@ struct Indenter
     unsigned int top    = 0;
     unsigned int indent = 0;
 
+    // Indentation prefix, built from the string repeated at the deepest indentation printed
+    mutable std::string prefix;
+    mutable std::string prefixString;
+
     Indenter & operator ++(int);
     Indenter & operator --(int);
     Indenter & operator ++(void);
@@ -50,6 +54,7 @@ struct Options
         std::string         stateType       = "int";
         std::string         topState        = "topState()";
         ParameterizedString popState        = "popStates(<NB_STATES>);";
+        ParameterizedString pushState       = "pushState(<STATE>);";
         std::string         errorState      = "-1";
         std::string         acceptState     = "-2";
 
@@ -64,6 +69,8 @@ struct Options
         // Lexer options
         std::string         tokenType       = "int";
         std::string         shiftToken      = "shiftToken();";
+        std::string         currentToken    = "token";
+        std::string         lexerType       = "";
         std::string         tokenPrefix     = "";
         ParameterizedString getTypeOfToken  = "<TOKEN>";
         std::string         endOfInputToken = "END_OF_INPUT";
@@ -73,20 +80,29 @@ struct Options
         std::string         parseFunctionName   = "parse";
         std::string         branchFunctionName  = "branch";
         std::string         throwedExceptions   = "";
+        std::string         parserStruct        = "";
+        std::string         instrumentFile      = "";
+        std::string         profileFile         = "";
 
         bool                defaultSwitchStatement = false;
         bool                useTableForBranches    = false;
+        bool                useCompressedTables    = false;
+        bool                useComputedGotos       = false;
+        bool                useConstexprTables     = false;
+        bool                fuseReduces            = false;
 
         std::string         inputFileName;
         std::string         outputFileName;
 
         // Internal
         std::string         tokenName        = "yytoken";
+        ParameterizedString pushToken        = "";
         std::string         intermediateName = "intermediate";
 
         Indenter            indent;
 
         DebugLevel          debugLevel = DebugLevel::NONE;
+        unsigned int        nbJobs     = 0;
 
         Errors<CommandLineParsingError> errors;
 
@@ -3,6 +3,7 @@
 namespace Vars
 {
     const std::string NB_STATES      ("<NB_STATES>");
+    const std::string STATE          ("<STATE>");
     const std::string VALUE          ("<VALUE>");
     const std::string VALUE_IDX      ("<VALUE_IDX>");
     const std::string NB_VALUES      ("<NB_VALUES>");
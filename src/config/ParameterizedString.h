@@ -11,6 +11,7 @@
 namespace Vars
 {
     extern const std::string NB_STATES;
+    extern const std::string STATE;
     extern const std::string VALUE;
     extern const std::string NB_VALUES;
     extern const std::string VALUE_IDX;
@@ -7,7 +7,6 @@
 #include "Grammar.h"
 #include "config/Options.h"
 #include "printer/PrettyPrinters.h"
-#include "utils/Algos.h"
 
 #include <sstream>
 
@@ -27,48 +26,54 @@ const std::string Grammar::START_RULE("START");
 void Grammar::addRule(Rule & rule)
 {
     rule.numRule = rules.size() + 1;
-    rules.insert(RuleMap::value_type(rule.name, rule));
+    rules.insert(RuleMap::value_type(rule.intermediate.id, rule));
 }
 
 const Rule & Grammar::getStartRule(void) const
 {
-    RuleIterator it = rules.find(Grammar::START_RULE);
+    RuleIterator it = rules.find(intermediates.at(Grammar::START_RULE).id);
 
     return it->second;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-Grammar::RuleRange Grammar::operator[](const std::string & name) const
+Grammar::RuleRange Grammar::operator[](const Symbol & intermediate) const
 {
-    return rules.equal_range(name);
+    return rules.equal_range(intermediate.id);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 Symbol Grammar::addTerminal(const std::string & name)
 {
-    terminals.insert(name);
-    return Symbol({Symbol::Type::TERMINAL, name});
-}
+    auto inserted = terminals.emplace(name, Symbol({ Symbol::Type::TERMINAL, (int) terminalsById.size(), name }));
+    if(inserted.second)
+        terminalsById.push_back(inserted.first->second);
 
-////////////////////////////////////////////////////////////////////////////////
-Symbol Grammar::addTerminal(std::string && name)
-{
-    terminals.insert(name);
-    return Symbol({Symbol::Type::TERMINAL, name});
+    return inserted.first->second;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 Symbol Grammar::addIntermediate(const std::string & name)
 {
-    intermediates.insert(name);
-    return Symbol({ Symbol::Type::INTERMEDIATE, name });
+    auto inserted = intermediates.emplace(name, Symbol({ Symbol::Type::INTERMEDIATE, (int) intermediatesById.size(), name }));
+    if(inserted.second)
+        intermediatesById.push_back(inserted.first->second);
+
+    return inserted.first->second;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-Symbol Grammar::addIntermediate(std::string && name)
+void Grammar::setEndOfInput(const std::string & name)
 {
-    intermediates.insert(name);
-    return Symbol({ Symbol::Type::INTERMEDIATE, std::forward<std::string>(name) });
+    // End of input token is usually not used by rules, it then takes the next free terminal id
+    auto it = terminals.find(name);
+    if(it != terminals.end())
+        endOfInput = it->second;
+    else
+    {
+        endOfInput = Symbol({ Symbol::Type::TERMINAL, (int) terminalsById.size(), name });
+        terminalsById.push_back(endOfInput);
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -78,28 +83,29 @@ const std::string & Grammar::getIntermediateType(const std::string & name) const
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-size_t Grammar::getIntermediateIndex(const std::string & name) const
-{
-    return std::distance(intermediates.begin(), intermediates.find(name));
-}
-
-////////////////////////////////////////////////////////////////////////////////
-SymbolSet Grammar::first(const SymbolList & list) const
+bool Grammar::first(SymbolList::const_iterator begin, SymbolList::const_iterator end, TerminalSet & firstSet) const
 {
-    if(list[0].isTerminal())
-        return { list[0] };
-
-    SymbolSet firstSet;
-    for_each(rules.equal_range(list[0].name), [&](const auto & rule)
+    // Add FIRST of the symbols sequence to 'firstSet' and tell if the whole sequence is nullable
+    for(auto symbol = begin; symbol != end; ++symbol)
     {
-        if(rule.second.symbols != list)
+        if(symbol->isTerminal())
         {
-            const auto firstIntermediate = this->first(rule.second.symbols); // GCC 6.3 bug : need to explicitly use 'this->'
-            firstSet.insert(firstIntermediate.begin(), firstIntermediate.end());
+            firstSet.insert(*symbol);
+            return false;
         }
-    });
 
-    return firstSet;
+        firstSet.insert(firstSets[symbol->id]);
+        if(!nullables[symbol->id])
+            return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool Grammar::isNullable(const Symbol & symbol) const
+{
+    return symbol.isIntermediate() && nullables[symbol.id];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -111,10 +117,16 @@ void Grammar::replacePseudoVariables(Options & options)
         if(rule.action.empty())
             rule.action = options.defaultAction.toString();
 
+        // A unit rule only copying its value can be bypassed by the parser
+        const std::string copyAction = Options::DEFAULT.defaultAction.toString();
+        rule.isUnitCopy = (rule.symbols.size() == 1) && rule.symbols[0].isIntermediate()
+            && (rule.action.substr(0, rule.action.find_last_not_of(" \t\r\n") + 1) == copyAction)
+            && (intermediateTypes.at(rule.intermediate.name) == intermediateTypes.at(rule.symbols[0].name));
+
         // Replace return pseudo-variable '$$'
         ParameterizedString replacement = options.valueAsIntermediate
             .replaceParam(Vars::VALUE, Vars::RETURN)
-            .replaceParam(Vars::TYPE, intermediateTypes.at(rule.name));
+            .replaceParam(Vars::TYPE, intermediateTypes.at(rule.intermediate.name));
         ParameterizedString parameterizedAction = ParameterizedString(rule.action)
             .replaceParam(Vars::EXTERNAL_RETURN, replacement.toString());
 
@@ -147,9 +159,10 @@ void Grammar::replacePseudoVariables(Options & options)
 void Grammar::check(void)
 {
     // Check start rule
-    if(intermediates.find(Grammar::START_RULE) != intermediates.end())
+    auto startIntermediate = intermediates.find(Grammar::START_RULE);
+    if(startIntermediate != intermediates.end())
     {
-        Grammar::RuleMap::size_type nbStartsRules = rules.count(Grammar::START_RULE);
+        Grammar::RuleMap::size_type nbStartsRules = rules.count(startIntermediate->second.id);
 
         if(nbStartsRules == 0)
             ADD_GENERATING_ERROR("No start rule '" + Grammar::START_RULE + "' found");
@@ -159,8 +172,35 @@ void Grammar::check(void)
     else
         ADD_GENERATING_ERROR("No start rule '" + Grammar::START_RULE + "' found");
 
-    // Check intermediates types
-    for(const auto & intermediate : intermediates)
-        if(intermediateTypes.find(intermediate) == intermediateTypes.end())
-            ADD_GENERATING_ERROR("Intermediate '" + intermediate + "' has no type");
+    // Check intermediates types, in order of appearance
+    for(const auto & intermediate : intermediatesById)
+        if(intermediateTypes.find(intermediate.name) == intermediateTypes.end())
+            ADD_GENERATING_ERROR("Intermediate '" + intermediate.name + "' has no type");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Grammar::computeFirstSets(void)
+{
+    firstSets.assign(intermediates.size(), TerminalSet(terminalsById));
+    nullables.assign(intermediates.size(), false);
+
+    // Fixpoint : FIRST sets & nullability only grow, so loop until nothing changes anymore
+    bool changed = true;
+    while(changed)
+    {
+        changed = false;
+        for(const auto & pair : rules)
+        {
+            const Rule & rule = pair.second;
+            TerminalSet ruleFirstSet(terminalsById);
+            const bool isRuleNullable = first(rule.symbols.begin(), rule.symbols.end(), ruleFirstSet);
+
+            changed |= firstSets[rule.intermediate.id].insert(ruleFirstSet);
+            if(isRuleNullable && !nullables[rule.intermediate.id])
+            {
+                nullables[rule.intermediate.id] = true;
+                changed = true;
+            }
+        }
+    }
 }
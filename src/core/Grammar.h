@@ -8,21 +8,25 @@
 #define GRAMMAR_H
 #include "Rule.h"
 #include "Symbol.h"
+#include "TerminalSet.h"
 #include "Errors.h"
 
+#include <map>
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
+#include <vector>
 
 struct Options;
 
 class Grammar
 {
     public :
-        typedef std::unordered_set<std::string> Dictionary;
-        typedef std::unordered_map<std::string, std::string>      IntermediateTypeDictionary;
+        typedef std::unordered_map<std::string, Symbol>      SymbolTable;
+        typedef std::unordered_map<std::string, std::string> IntermediateTypeDictionary;
 
-        typedef std::unordered_multimap<std::string, Rule>  RuleMap;
+        // Rules of an intermediate are kept in order of declaration
+        typedef std::multimap<int, Rule>                    RuleMap;
         typedef RuleMap::const_iterator                     RuleIterator;
         typedef std::pair<RuleIterator, RuleIterator>       RuleRange;
 
@@ -31,28 +35,35 @@ class Grammar
     public :
         void         addRule(Rule & rule);
         const Rule & getStartRule(void) const;
-        RuleRange    operator[](const std::string & name) const;
+        RuleRange    operator[](const Symbol & intermediate) const;
 
         Symbol addTerminal(const std::string & name);
-        Symbol addTerminal(std::string && name);
         Symbol addIntermediate(const std::string & name);
-        Symbol addIntermediate(std::string && name);
+        void   setEndOfInput(const std::string & name);
 
         const std::string & getIntermediateType(const std::string & name) const;
-        size_t getIntermediateIndex(const std::string & name) const;
 
-        SymbolSet first(const SymbolList & list) const;
+        bool first(SymbolList::const_iterator begin, SymbolList::const_iterator end, TerminalSet & firstSet) const;
+        bool isNullable(const Symbol & symbol) const;
 
         void replacePseudoVariables(Options & options);
         void check(void);
+        void computeFirstSets(void);
 
         Errors<GeneratingError> errors;
 
     public :
         RuleMap                     rules;
 
-        Dictionary                  terminals;
-        Dictionary                  intermediates;
+        SymbolTable                 terminals;
+        SymbolTable                 intermediates;
+        SymbolList                  terminalsById;  // Including end of input
+        SymbolList                  intermediatesById;  // In order of appearance, numbering branches
+        Symbol                      endOfInput = { Symbol::Type::TERMINAL, -1, "" };
+
+        // FIRST set & nullability of each intermediate, indexed by id
+        std::vector<TerminalSet>    firstSets;
+        std::vector<bool>           nullables;
 
         IntermediateTypeDictionary intermediateTypes;
 };
@@ -6,8 +6,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "ParserState.h"
 #include "Rule.h"
+#include "utils/Algos.h"
 
 #include <map>
+#include <iterator>
 
 ////////////////////////////////////////////////////////////////////////////////
 Item::Item(const Rule & rule, SymbolList::const_iterator dottedSymbol, ParserState * nextState)
@@ -16,8 +18,8 @@ Item::Item(const Rule & rule, SymbolList::const_iterator dottedSymbol, ParserSta
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-Item::Item(const Rule & rule, SymbolList::const_iterator dottedSymbol, ParserState * nextState, SymbolSet && lookaheads)
-: rule(rule), dottedSymbol(dottedSymbol), nextState(nextState), lookaheads(std::forward<SymbolSet>(lookaheads))
+Item::Item(const Rule & rule, SymbolList::const_iterator dottedSymbol, ParserState * nextState, TerminalSet && lookaheads)
+: rule(rule), dottedSymbol(dottedSymbol), nextState(nextState), lookaheads(std::forward<TerminalSet>(lookaheads))
 {
 }
 
@@ -60,13 +62,26 @@ bool Item::isDotAtEnd(void) const
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-bool Item::isNextSymbolEqualTo(const std::string & name) const
+bool Item::isKernel(void) const
 {
-    return !isDotAtEnd() && dottedSymbol->name == name;
+    // Start item and all items with the dot moved forward
+    return dottedSymbol != rule.symbols.begin() || rule.numRule == 1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-bool Item::isTerminalInLookaheads(const std::string & terminal) const
+bool Item::isNextSymbolEqualTo(const Symbol & symbol) const
 {
-    return lookaheads.empty() || lookaheads.find({ Symbol::Type::TERMINAL, terminal }) != lookaheads.end();
+    return !isDotAtEnd() && *dottedSymbol == symbol;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool Item::isTerminalInLookaheads(const Symbol & terminal) const
+{
+    return lookaheads.empty() || lookaheads.contains(terminal);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+size_t Item::getCoreHash(void) const
+{
+    return hash_combine(std::hash<int>()(rule.numRule), std::distance(rule.symbols.begin(), dottedSymbol));
 }
@@ -7,6 +7,7 @@
 #ifndef ITEM_H
 #define ITEM_H
 #include "Symbol.h"
+#include "TerminalSet.h"
 
 class Rule;
 class ParserState;
@@ -23,11 +24,11 @@ struct Item
     const Rule & rule;
     SymbolList::const_iterator dottedSymbol;
     ParserState * nextState;
-    SymbolSet lookaheads;
+    TerminalSet lookaheads;
 
 
     Item(const Rule & rule, SymbolList::const_iterator dot, ParserState * nextState);
-    Item(const Rule & rule, SymbolList::const_iterator dot, ParserState * nextState, SymbolSet && lookahead);
+    Item(const Rule & rule, SymbolList::const_iterator dot, ParserState * nextState, TerminalSet && lookahead);
 
     bool operator ==(const Item & item) const;
     bool operator < (const Item & item) const;
@@ -37,8 +38,11 @@ struct Item
     bool isReduce(void) const { return getType() == ActionType::REDUCE; }
 
     bool isDotAtEnd(void) const;
-    bool isNextSymbolEqualTo(const std::string & name) const;
-    bool isTerminalInLookaheads(const std::string & terminal) const;
+    bool isKernel(void) const;
+    bool isNextSymbolEqualTo(const Symbol & symbol) const;
+    bool isTerminalInLookaheads(const Symbol & terminal) const;
+
+    size_t getCoreHash(void) const;
 };
 
 #endif /* ITEM_H */
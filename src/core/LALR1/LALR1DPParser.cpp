@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#include "LALR1DPParser.h"
+#include "core/Grammar.h"
+
+#include <algorithm>
+#include <limits>
+
+// See F. DeRemer & T. Pennello, "Efficient Computation of LALR(1) Look-Ahead Sets", 1982.
+// For each transition (p, A) of the LR0 automaton on an intermediate A :
+//   DR(p, A)     = terminals shifted from state goto(p, A)
+//   Read(p, A)   = DR(p, A)   U Read(r, C)   for each (p, A) 'reads' (r, C)
+//   Follow(p, A) = Read(p, A) U Follow(q, B) for each (p, A) 'includes' (q, B)
+// And for each reduce item 'A -> w.' of a state :
+//   LA(q, A -> w) = Follow(p, A) for each (q, A -> w) 'lookback' (p, A)
+
+////////////////////////////////////////////////////////////////////////////////
+void LALR1DPParser::generateStates(void)
+{
+    LR0Parser::generateStates();
+    collectTransitions();
+
+    std::vector<TerminalSet> follows = computeDirectReads();
+    digraph(computeReads(), follows);
+
+    std::vector<Lookback> lookbacks;
+    digraph(computeIncludes(lookbacks), follows);
+
+    for(const auto & lookback : lookbacks)
+        lookback.item->lookaheads.insert(follows[lookback.transition]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LALR1DPParser::addTransition(ParserState & from, ParserState * to, const Symbol & intermediate)
+{
+    const size_t key = from.numState * m_grammar.intermediates.size() + intermediate.id;
+
+    auto inserted = m_transitionsIndex.emplace(key, m_transitions.size());
+    if(inserted.second)
+        m_transitions.push_back({ &from, to, intermediate });
+    else if(to != nullptr)
+        m_transitions[inserted.first->second].to = to; // Start intermediate also used inside a rule
+}
+
+////////////////////////////////////////////////////////////////////////////////
+size_t LALR1DPParser::getTransition(const ParserState & from, const Symbol & intermediate) const
+{
+    return m_transitionsIndex.at(from.numState * m_grammar.intermediates.size() + intermediate.id);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LALR1DPParser::collectTransitions(void)
+{
+    m_statesByNum.resize(m_states.size());
+    for(auto & state : m_states)
+        m_statesByNum[state->numState] = state.get();
+
+    // Start rule is reduced on end of input only : it behaves as a pseudo transition
+    // on the start intermediate whose successor only reads the end of input
+    addTransition(*m_states.front(), nullptr, m_grammar.getStartRule().intermediate);
+
+    for(auto & state : m_states)
+        for(const auto & item : state->items)
+            if(item.isShift() && item.dottedSymbol->isIntermediate())
+                addTransition(*state, item.nextState, *item.dottedSymbol);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<TerminalSet> LALR1DPParser::computeDirectReads(void) const
+{
+    std::vector<TerminalSet> directReads(m_transitions.size(), TerminalSet(m_grammar.terminalsById));
+
+    directReads[getTransition(*m_states.front(), m_grammar.getStartRule().intermediate)].insert(m_grammar.endOfInput);
+
+    for(size_t i = 0; i < m_transitions.size(); i++)
+    {
+        if(m_transitions[i].to == nullptr)
+            continue;
+
+        for(const auto & item : m_transitions[i].to->items)
+            if(item.isShift() && item.dottedSymbol->isTerminal())
+                directReads[i].insert(*item.dottedSymbol);
+    }
+
+    return directReads;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LALR1DPParser::Relation LALR1DPParser::computeReads(void) const
+{
+    // (p, A) reads (r, C) if r = goto(p, A) and C is nullable
+    Relation reads(m_transitions.size());
+
+    for(size_t i = 0; i < m_transitions.size(); i++)
+    {
+        if(m_transitions[i].to == nullptr)
+            continue;
+
+        for(const auto & item : m_transitions[i].to->items)
+            if(item.isShift() && m_grammar.isNullable(*item.dottedSymbol))
+                reads[i].push_back(getTransition(*m_transitions[i].to, *item.dottedSymbol));
+    }
+
+    return reads;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LALR1DPParser::Relation LALR1DPParser::computeIncludes(std::vector<Lookback> & lookbacks) const
+{
+    // (p, A) includes (q, B) if B -> uAv, v is nullable and p = goto(q, u)
+    // (r, B -> w) lookback (q, B) if r = goto(q, w)
+    Relation includes(m_transitions.size());
+
+    for(size_t i = 0; i < m_transitions.size(); i++)
+    {
+        const Transition & transition = m_transitions[i];
+
+        for(const auto & closureItem : transition.from->items)
+        {
+            const Rule & rule = closureItem.rule;
+            if(rule.intermediate != transition.intermediate || closureItem.dottedSymbol != rule.symbols.begin())
+                continue;
+
+            // All symbols from 'nullableSuffix' up to the end of the rule are nullable
+            auto nullableSuffix = rule.symbols.end();
+            while(nullableSuffix != rule.symbols.begin() && m_grammar.isNullable(*(nullableSuffix - 1)))
+                --nullableSuffix;
+
+            // Walk the rule through the automaton
+            const ParserState * state = transition.from;
+            for(auto symbol = rule.symbols.begin(); symbol != rule.symbols.end(); ++symbol)
+            {
+                if(symbol->isIntermediate() && symbol + 1 >= nullableSuffix)
+                    includes[getTransition(*state, *symbol)].push_back(i);
+
+                state = state->getGoto(*symbol);
+            }
+
+            for(auto & item : m_statesByNum[state->numState]->items)
+                if(item.isReduce() && &item.rule == &rule)
+                    lookbacks.push_back({ &item, i });
+        }
+    }
+
+    return includes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LALR1DPParser::digraph(const Relation & relation, std::vector<TerminalSet> & sets)
+{
+    std::vector<size_t> depths(sets.size(), 0);
+    std::vector<size_t> stack;
+
+    for(size_t x = 0; x < sets.size(); x++)
+        if(depths[x] == 0)
+            traverse(x, relation, sets, depths, stack);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LALR1DPParser::traverse(size_t x, const Relation & relation, std::vector<TerminalSet> & sets, std::vector<size_t> & depths, std::vector<size_t> & stack)
+{
+    stack.push_back(x);
+    const size_t depth = stack.size();
+    depths[x] = depth;
+
+    for(const size_t y : relation[x])
+    {
+        if(depths[y] == 0)
+            traverse(y, relation, sets, depths, stack);
+
+        depths[x] = std::min(depths[x], depths[y]);
+        sets[x].insert(sets[y]);
+    }
+
+    // All elements of a strongly connected component share the same set (Tarjan)
+    if(depths[x] == depth)
+    {
+        size_t top;
+        do
+        {
+            top = stack.back();
+            stack.pop_back();
+            depths[top] = std::numeric_limits<size_t>::max();
+            sets[top] = sets[x];
+        }
+        while(top != x);
+    }
+}
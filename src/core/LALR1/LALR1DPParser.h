@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef LALR1DPPARSER_H
+#define LALR1DPPARSER_H
+#include "core/LR0/LR0Parser.h"
+#include "core/TerminalSet.h"
+
+#include <vector>
+#include <unordered_map>
+
+// LALR1 parser built upon the LR0 automaton, the lookaheads being computed
+// afterward with DeRemer & Pennello's 'reads' and 'includes' relations
+class LALR1DPParser : public LR0Parser
+{
+    public :
+        using LR0Parser::LR0Parser;
+
+        void generateStates(void) override;
+
+    private :
+        using Relation = std::vector<std::vector<size_t>>;
+
+        // Transition of the LR0 automaton on an intermediate
+        struct Transition
+        {
+            ParserState * from;
+            ParserState * to;
+            Symbol        intermediate;
+        };
+
+        // Reduce item looking back to a transition
+        struct Lookback
+        {
+            Item * item;
+            size_t transition;
+        };
+
+        void   addTransition(ParserState & from, ParserState * to, const Symbol & intermediate);
+        size_t getTransition(const ParserState & from, const Symbol & intermediate) const;
+        void   collectTransitions(void);
+
+        std::vector<TerminalSet> computeDirectReads(void) const;
+        Relation                 computeReads(void) const;
+        Relation                 computeIncludes(std::vector<Lookback> & lookbacks) const;
+
+        static void digraph(const Relation & relation, std::vector<TerminalSet> & sets);
+        static void traverse(size_t x, const Relation & relation, std::vector<TerminalSet> & sets, std::vector<size_t> & depths, std::vector<size_t> & stack);
+
+        std::vector<ParserState *>         m_statesByNum;
+        std::vector<Transition>            m_transitions;
+        std::unordered_map<size_t, size_t> m_transitionsIndex;
+};
+
+#endif /* LALR1DPPARSER_H */
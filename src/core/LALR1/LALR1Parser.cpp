@@ -12,24 +12,24 @@
 ////////////////////////////////////////////////////////////////////////////////
 ParserState::Ptr LALR1Parser::createStartState(void)
 {
-    auto startState = std::make_unique<LALR1State>();
+    auto startState = m_arena.create<LALR1State>(m_arena);
     auto & startRule = m_grammar.getStartRule();
-    startState->addItem(startRule, startRule.symbols.begin(), { { Symbol::Type::TERMINAL, m_options.endOfInputToken } });
+    startState->addItem(startRule, startRule.symbols.begin(), TerminalSet(m_grammar.terminalsById, m_grammar.endOfInput));
     return std::move(startState);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-std::unordered_map<std::string, ParserState::Ptr> LALR1Parser::createSuccessorStates(const ParserState::Ptr & state)
+Parser::Successors LALR1Parser::createSuccessorStates(const ParserState::Ptr & state, Workspace & workspace)
 {
-    std::unordered_map<std::string, ParserState::Ptr> allSuccessors;
+    Successors allSuccessors;
 
     // Create a new state for each successing symbol of the current state
     for(const auto & item : state->items)
     {
         if(!item.isDotAtEnd())
         {
-            auto & newState = fetchOrInsertState<LALR1State>(allSuccessors, item.dottedSymbol->name);
-            newState.addItem(item.rule, item.dottedSymbol + 1, SymbolSet(item.lookaheads));
+            auto & newState = fetchOrInsertState<LALR1State>(allSuccessors, *item.dottedSymbol, workspace);
+            newState.addItem(item.rule, item.dottedSymbol + 1, TerminalSet(item.lookaheads));
         }
     }
 
@@ -5,28 +5,31 @@
 // License. See LICENSE for details.
 ////////////////////////////////////////////////////////////////////////////////
 #include "LALR1State.h"
-#include "utils/Algos.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 bool LALR1State::isMergeableWith(const ParserState::Ptr & state)
 {
-    if(items.size() != state->items.size())
-        return false;
-
-    return all_of_pairs(items, state->items, [](auto & itemThis, auto & itemState)
-    {
-            return itemThis.dottedSymbol == itemState.dottedSymbol
-                && itemThis.rule         == itemState.rule;
-        });
+    KernelPairs kernelPairs;
+    return pairKernelItems(*state, kernelPairs);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void LALR1State::merge(Ptr & state)
+bool LALR1State::merge(const Ptr & state)
 {
-    for_each_pair(items, state->items, [](auto & itemThis, auto & itemState)
-    {
-        for(auto && lookahead : itemState.lookaheads)
-            itemThis.lookaheads.insert(std::move(lookahead));
-    });
+    KernelPairs kernelPairs;
+    pairKernelItems(*state, kernelPairs);
+
+    bool lookaheadsChanged = false;
+    for(const auto & kernelPair : kernelPairs)
+        lookaheadsChanged |= kernelPair.first->lookaheads.insert(kernelPair.second->lookaheads);
+
+    return lookaheadsChanged;
 }
 
+
+////////////////////////////////////////////////////////////////////////////////
+size_t LALR1State::getKernelSignature(void) const
+{
+    // Lookaheads are merged, so they must not be part of the signature
+    return ParserState::getKernelSignature();
+}
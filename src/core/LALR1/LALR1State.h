@@ -11,10 +11,12 @@
 class LALR1State : public LR1State
 {
     public :
+        using LR1State::LR1State;
         virtual ~LALR1State(void) = default;
 
         bool isMergeableWith(const Ptr & state) override;
-        void merge(Ptr & state) override;
+        bool merge(const Ptr & state) override;
+        size_t getKernelSignature(void) const override;
 };
 
 #endif /* LALR1STATE_H */
@@ -11,23 +11,23 @@
 ////////////////////////////////////////////////////////////////////////////////
 ParserState::Ptr LR0Parser::createStartState(void)
 {
-    auto startState = std::make_unique<LR0State>();
+    auto startState = m_arena.create<LR0State>(m_arena);
     auto & startRule = m_grammar.getStartRule();
     startState->addItem(startRule, startRule.symbols.begin());
     return std::move(startState);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-std::unordered_map<std::string, ParserState::Ptr> LR0Parser::createSuccessorStates(const ParserState::Ptr & state)
+Parser::Successors LR0Parser::createSuccessorStates(const ParserState::Ptr & state, Workspace & workspace)
 {
-    std::unordered_map<std::string, ParserState::Ptr> allSuccessors;
+    Successors allSuccessors;
 
     // Create a new state for each successing symbol of the current state
     for(const auto & item : state->items)
     {
         if(!item.isDotAtEnd())
         {
-            auto & newState = fetchOrInsertState<LR0State>(allSuccessors, item.dottedSymbol->name);
+            auto & newState = fetchOrInsertState<LR0State>(allSuccessors, *item.dottedSymbol, workspace);
             newState.addItem(item.rule, item.dottedSymbol + 1);
         }
     }
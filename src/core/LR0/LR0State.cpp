@@ -8,6 +8,14 @@
 #include "core/Rule.h"
 #include "utils/Algos.h"
 
+#include <algorithm>
+
+////////////////////////////////////////////////////////////////////////////////
+LR0State::LR0State(Arena & arena)
+: ParserState(arena)
+{
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void LR0State::addItem(const Rule & rule, SymbolList::const_iterator dottedSymbol)
 {
@@ -26,29 +34,29 @@ void LR0State::addItemsRange(const Grammar::RuleRange & ruleRange)
 ////////////////////////////////////////////////////////////////////////////////
 void LR0State::close(const Grammar & grammar)
 {
-    for(auto & item : items)
+    // Items are appended while iterating, so they are accessed by index
+    for(size_t i = 0; i < items.size(); i++)
     {
-        if(item.isDotAtEnd())
+        if(items[i].isDotAtEnd())
             continue;
 
-        const Symbol & symbol = *item.dottedSymbol;
+        const Symbol & symbol = *items[i].dottedSymbol;
 
         if(symbolNeedsToBeClosed(symbol))
-            addItemsRange(grammar[symbol.name]);
+            addItemsRange(grammar[symbol]);
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool LR0State::isMergeableWith(const ParserState::Ptr & state)
 {
-    if(items.size() != state->items.size())
+    // Closure items only depend on kernel items, which may come in any order
+    const auto nbKernelItems = std::count_if(items.begin(), items.end(), [](const auto & item) { return item.isKernel(); });
+    const auto nbStateKernelItems = std::count_if(state->items.begin(), state->items.end(), [](const auto & item) { return item.isKernel(); });
+    if(nbKernelItems != nbStateKernelItems)
         return false;
 
-    return all_of_pairs(items, state->items, [](auto & itemThis, auto & itemState)
-    {
-        return itemThis.dottedSymbol == itemState.dottedSymbol
-            && itemThis.rule         == itemState.rule;
-    });
+    return std::all_of(items.begin(), items.end(), [&state](const auto & item) { return !item.isKernel() || state->contains(item); });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -14,6 +14,8 @@ class Rule;
 class LR0State : public ParserState
 {
     public :
+        LR0State(Arena & arena);
+
         void addItem(const Rule & rule, SymbolList::const_iterator dottedSymbol);
         void close(const Grammar & grammar) override;
         bool isMergeableWith(const Ptr & state) override;
@@ -16,7 +16,7 @@ class LR1Parser : public Parser
 
     protected :
         ParserState::Ptr createStartState(void) override;
-        std::unordered_map<std::string, ParserState::Ptr> createSuccessorStates(const ParserState::Ptr & state) override;
+        Successors createSuccessorStates(const ParserState::Ptr & state, Workspace & workspace) override;
 };
 
 #endif /* LR1PARSER_H */
@@ -8,45 +8,46 @@
 #include "core/Rule.h"
 #include "utils/Algos.h"
 
+#include <algorithm>
+#include <utility>
+
+static const size_t NO_ITEM      = static_cast<size_t>(-1);
+static const size_t COUNTED_ITEM = NO_ITEM - 1;
+
 ////////////////////////////////////////////////////////////////////////////////
-void LR1State::addItem(const Rule & rule, const SymbolList::const_iterator dottedSymbol, SymbolSet && lookahead)
+LR1State::LR1State(Arena & arena)
+: ParserState(arena)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool LR1State::addItem(const Rule & rule, const SymbolList::const_iterator dottedSymbol, TerminalSet && lookahead)
 {
     // If the item already exist, merge the lookaheads
-    for(auto & item : items)
-    {
-        if(dottedSymbol == item.dottedSymbol && rule == item.rule)
-        {
-            item.lookaheads.insert(lookahead.begin(), lookahead.end());
-            return;
-        }
-    }
+    Item * coreItem = findCoreItem(rule, dottedSymbol);
+    if(coreItem != nullptr)
+        return coreItem->lookaheads.insert(lookahead);
 
     // Add a new item
-    items.emplace_back(rule, dottedSymbol, nullptr, std::forward<SymbolSet>(lookahead));
+    items.emplace_back(rule, dottedSymbol, nullptr, std::forward<TerminalSet>(lookahead));
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void LR1State::addItemsRange(const Grammar::RuleRange & ruleRange, SymbolSet && lookahead)
+Item * LR1State::findCoreItem(const Rule & rule, const SymbolList::const_iterator dottedSymbol)
 {
-    for_each(ruleRange, [&](const auto & rule)
-    {
-        this->addItem(rule.second, rule.second.symbols.begin(), SymbolSet(lookahead)); // GCC 6.3 bug : need to explicitly use 'this->'
-    });
+    // Kernel items come first and are few, a linear search is enough
+    auto coreItem = std::find_if(items.begin(), items.end(), [&](const Item & item) { return item.dottedSymbol == dottedSymbol && item.rule.numRule == rule.numRule; });
+    return coreItem != items.end() ? &*coreItem : nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-SymbolSet allLookaheadsOf(const Item & item, const Grammar & grammar)
+TerminalSet allLookaheadsOf(const Item & item, const Grammar & grammar)
 {
-    SymbolList followingSymbols = item.rule.remainingSymbolsAfter(item.dottedSymbol);
-    followingSymbols.push_back({ Symbol::Type::TERMINAL, "" });
-
-    SymbolSet allLookaheads;
-    for(auto & lookahead : item.lookaheads)
-    {
-        followingSymbols.back() = lookahead;
-        auto first = grammar.first(followingSymbols);
-        allLookaheads.insert(first.begin(), first.end());
-    }
+    // FIRST(vx/y/z) is FIRST(v), plus x/y/z when 'v' is nullable
+    TerminalSet allLookaheads(grammar.terminalsById);
+    if(grammar.first(item.dottedSymbol + 1, item.rule.symbols.end(), allLookaheads))
+        allLookaheads.insert(item.lookaheads);
 
     return allLookaheads;
 }
@@ -54,29 +55,135 @@ SymbolSet allLookaheadsOf(const Item & item, const Grammar & grammar)
 ////////////////////////////////////////////////////////////////////////////////
 void LR1State::close(const Grammar & grammar)
 {
-    for(auto & item : items)
+    // Closure items are all of the form 'B –> •w', so they are indexed by rule number only.
+    // This index is reused by all the closures of a thread, and left empty after each one.
+    static thread_local std::vector<size_t> itemsByRule;
+    itemsByRule.resize(grammar.rules.size() + 1, NO_ITEM);
+
+    // Items added or whose lookaheads changed have to be closed (again).
+    // They are referred to by position, as adding items may move them.
+    static thread_local std::vector<size_t> pendingItems;
+    for(size_t i = 0; i < items.size(); i++)
     {
+        if(items[i].dottedSymbol == items[i].rule.symbols.begin())
+            itemsByRule[items[i].rule.numRule] = i;
+
+        pendingItems.push_back(i);
+    }
+
+    // Closure rules don't depend on lookaheads, they are counted first so that items are allocated once
+    static thread_local std::vector<const Rule *> rulesToCount;
+    size_t nbItems = items.size();
+    auto countRulesOf = [&](const Symbol & symbol)
+    {
+        for_each(grammar[symbol], [&](const auto & rule)
+        {
+            size_t & numItem = itemsByRule[rule.second.numRule];
+            if(numItem == NO_ITEM)
+            {
+                numItem = COUNTED_ITEM;
+                nbItems++;
+                rulesToCount.push_back(&rule.second);
+            }
+        });
+    };
+
+    for(const auto & item : items)
+        if(!item.isDotAtEnd() && item.dottedSymbol->isIntermediate())
+            countRulesOf(*item.dottedSymbol);
+
+    while(!rulesToCount.empty())
+    {
+        const Rule & rule = *rulesToCount.back();
+        rulesToCount.pop_back();
+
+        if(!rule.symbols.empty() && rule.symbols.front().isIntermediate())
+            countRulesOf(rule.symbols.front());
+    }
+
+    items.reserve(nbItems);
+
+    while(!pendingItems.empty())
+    {
+        const Item & item = items[pendingItems.back()];
+        pendingItems.pop_back();
+
         if(item.isDotAtEnd() || item.dottedSymbol->isTerminal())
             continue;
 
-        // Current item is of the form 'A –> u•Bv, x/y/z' (With dottedSymbol = B and lookaheads = x/y/z)
-        // We need to add each B production rule which have a lookahead 'v' followed by ether 'x', 'y' or 'z'
+        // Current item is of the form 'A –> u•Bv, x/y/z' (With dottedSymbol = B and lookaheads = x/y/z)
+        // We need to add each B production rule which have a lookahead 'v' followed by ether 'x', 'y' or 'z'
         // This lookahead is the concatenation of FIRST(vx), FIRST(vx) and FIRST(vx)
-        addItemsRange(grammar[item.dottedSymbol->name], allLookaheadsOf(item, grammar));
+        const TerminalSet lookahead = allLookaheadsOf(item, grammar);
+        for_each(grammar[*item.dottedSymbol], [&](const auto & rule)
+        {
+            size_t & numItem = itemsByRule[rule.second.numRule];
+            if(numItem == COUNTED_ITEM)
+            {
+                numItem = this->items.size(); // GCC 6.3 bug : need to explicitly use 'this->'
+                this->items.emplace_back(rule.second, rule.second.symbols.begin(), nullptr, TerminalSet(lookahead));
+                pendingItems.push_back(numItem);
+            }
+            else if(this->items[numItem].lookaheads.insert(lookahead))
+                pendingItems.push_back(numItem);
+        });
     }
+
+    for(const auto & item : items)
+        itemsByRule[item.rule.numRule] = NO_ITEM;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool LR1State::pairKernelItems(const ParserState & state, KernelPairs & kernelPairs)
+{
+    // Pair each kernel item of 'state' with the item of same core, whatever their order
+    kernelPairs.clear();
+    for(const auto & item : state.items)
+    {
+        if(!item.isKernel())
+            continue;
+
+        Item * coreItem = findCoreItem(item.rule, item.dottedSymbol);
+        if(coreItem == nullptr)
+            return false;
+
+        kernelPairs.emplace_back(coreItem, &item);
+    }
+
+    // And no other kernel item must be left
+    size_t nbKernelItems = 0;
+    for(const auto & item : items)
+        if(item.isKernel())
+            nbKernelItems++;
+
+    return nbKernelItems == kernelPairs.size();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool LR1State::isMergeableWith(const ParserState::Ptr & state)
 {
-    if(items.size() != state->items.size())
+    KernelPairs kernelPairs;
+    if(!pairKernelItems(*state, kernelPairs))
         return false;
 
-    return all_of_pairs(items, state->items, [](auto & itemThis, auto & itemState)
-    {
-        return itemThis.dottedSymbol == itemState.dottedSymbol
-            && itemThis.rule         == itemState.rule
-            && itemThis.lookaheads   == itemState.lookaheads;
-    });
+    for(const auto & kernelPair : kernelPairs)
+        if(kernelPair.first->lookaheads != kernelPair.second->lookaheads)
+            return false;
+
+    return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+size_t LR1State::getKernelSignature(void) const
+{
+    size_t signature = 0;
+    for(const auto & item : items)
+    {
+        if(!item.isKernel())
+            continue;
+
+        signature += hash_combine(item.getCoreHash(), item.lookaheads.hash());
+    }
+
+    return signature;
+}
@@ -9,19 +9,30 @@
 #include "core/ParserState.h"
 #include "core/Grammar.h"
 
+#include <utility>
+#include <vector>
+
 class Rule;
 
 class LR1State : public ParserState
 {
     public :
+        using KernelPairs = std::vector<std::pair<Item *, const Item *>>;
+
+    public :
+        LR1State(Arena & arena);
         virtual ~LR1State(void) = default;
 
-        void addItem(const Rule & rule, const SymbolList::const_iterator dottedSymbol, SymbolSet && lookahead);
+        bool addItem(const Rule & rule, const SymbolList::const_iterator dottedSymbol, TerminalSet && lookahead);
         void close(const Grammar & grammar) override;
         bool isMergeableWith(const Ptr & state) override;
+        size_t getKernelSignature(void) const override;
+
+    protected :
+        bool pairKernelItems(const ParserState & state, KernelPairs & kernelPairs);
 
     private :
-        void addItemsRange(const Grammar::RuleRange & ruleRange, SymbolSet && lookahead);
+        Item * findCoreItem(const Rule & rule, const SymbolList::const_iterator dottedSymbol);
 };
 
 #endif /* LR1STATE_H */
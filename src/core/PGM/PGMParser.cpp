@@ -0,0 +1,36 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#include "PGMParser.h"
+
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+ParserState::Ptr PGMParser::createStartState(void)
+{
+    auto startState = m_arena.create<PGMState>(m_arena);
+    auto & startRule = m_grammar.getStartRule();
+    startState->addItem(startRule, startRule.symbols.begin(), TerminalSet(m_grammar.terminalsById, m_grammar.endOfInput));
+    return std::move(startState);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Parser::Successors PGMParser::createSuccessorStates(const ParserState::Ptr & state, Workspace & workspace)
+{
+    Successors allSuccessors;
+
+    // Create a new state for each successing symbol of the current state
+    for(const auto & item : state->items)
+    {
+        if(!item.isDotAtEnd())
+        {
+            auto & newState = fetchOrInsertState<PGMState>(allSuccessors, *item.dottedSymbol, workspace);
+            newState.addItem(item.rule, item.dottedSymbol + 1, TerminalSet(item.lookaheads));
+        }
+    }
+
+    return allSuccessors;
+}
@@ -0,0 +1,24 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef PGMPARSER_H
+#define PGMPARSER_H
+#include "core/Parser.h"
+#include "PGMState.h"
+
+// Minimal LR1 parser (Pager's General Method) : LR1 states are merged as
+// long as they are weakly compatible, which keeps the full LR1 power
+class PGMParser : public Parser
+{
+    public :
+        using Parser::Parser;
+
+    protected :
+        ParserState::Ptr createStartState(void) override;
+        Successors createSuccessorStates(const ParserState::Ptr & state, Workspace & workspace) override;
+};
+
+#endif /* PGMPARSER_H */
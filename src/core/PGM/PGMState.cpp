@@ -0,0 +1,38 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#include "PGMState.h"
+
+////////////////////////////////////////////////////////////////////////////////
+bool PGMState::isMergeableWith(const ParserState::Ptr & state)
+{
+    // Both states must have the same kernel items, whatever their order
+    KernelPairs kernelPairs;
+    if(!pairKernelItems(*state, kernelPairs))
+        return false;
+
+    // Pager's weak compatibility : merging must not bring a lookahead to two
+    // items unless they already shared a lookahead in one of the states
+    for(size_t i = 0; i < kernelPairs.size(); i++)
+    {
+        const TerminalSet & thisLookaheadsI  = kernelPairs[i].first->lookaheads;
+        const TerminalSet & stateLookaheadsI = kernelPairs[i].second->lookaheads;
+
+        for(size_t j = i + 1; j < kernelPairs.size(); j++)
+        {
+            const TerminalSet & thisLookaheadsJ  = kernelPairs[j].first->lookaheads;
+            const TerminalSet & stateLookaheadsJ = kernelPairs[j].second->lookaheads;
+
+            const bool mixedLookaheads  = thisLookaheadsI.intersects(stateLookaheadsJ) || thisLookaheadsJ.intersects(stateLookaheadsI);
+            const bool sharedLookaheads = thisLookaheadsI.intersects(thisLookaheadsJ)  || stateLookaheadsI.intersects(stateLookaheadsJ);
+
+            if(mixedLookaheads && !sharedLookaheads)
+                return false;
+        }
+    }
+
+    return true;
+}
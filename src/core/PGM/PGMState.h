@@ -0,0 +1,20 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef PGMSTATE_H
+#define PGMSTATE_H
+#include "core/LALR1/LALR1State.h"
+
+class PGMState : public LALR1State
+{
+    public :
+        using LALR1State::LALR1State;
+        virtual ~PGMState(void) = default;
+
+        bool isMergeableWith(const Ptr & state) override;
+};
+
+#endif /* PGMSTATE_H */
@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#include "ParseTable.h"
+#include "ParserState.h"
+#include "Grammar.h"
+#include "Rule.h"
+
+#include <algorithm>
+#include <map>
+
+const int ParseTable::NO_STATE;
+
+////////////////////////////////////////////////////////////////////////////////
+ParseTable::ParseTable(const Grammar & grammar, size_t nbStates)
+: m_nbTerminals(grammar.terminalsById.size()), m_nbIntermediates(grammar.intermediates.size()), m_endOfInputId(grammar.endOfInput.id),
+  m_actions(nbStates * m_nbTerminals), m_defaultActions(nbStates), m_isConsistent(nbStates, false), m_gotos(nbStates * m_nbIntermediates, NO_STATE), m_predecessors(nbStates), m_accessingSymbols(nbStates, nullptr), m_rulesByNum(grammar.rules.size() + 1, nullptr)
+{
+    for(const auto & rule : grammar.rules)
+        m_rulesByNum[rule.second.numRule] = &rule.second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ParseTable::addState(const ParserState & state)
+{
+    ParsingAction * actions = &m_actions[state.numState * m_nbTerminals];
+    int *           gotos   = &m_gotos[state.numState * m_nbIntermediates];
+
+    std::vector<int> successors;
+
+    // Shift & accept actions take precedence over reduce actions, the first one found is kept
+    for(const auto & item : state.items)
+    {
+        if(item.isShift())
+        {
+            const Symbol & symbol = *item.dottedSymbol;
+            if(std::find(successors.begin(), successors.end(), item.nextState->numState) == successors.end())
+            {
+                successors.push_back(item.nextState->numState);
+                m_predecessors[item.nextState->numState].push_back(state.numState);
+                m_accessingSymbols[item.nextState->numState] = &symbol;
+            }
+
+            if(symbol.isIntermediate())
+                gotos[symbol.id] = item.nextState->numState;
+            else if(!actions[symbol.id].isShiftOrAccept())
+                actions[symbol.id] = ParsingAction(ParsingAction::Type::SHIFT, item.nextState->numState);
+        }
+        else if(item.rule.numRule == 1)
+        {
+            if(!actions[m_endOfInputId].isShiftOrAccept())
+                actions[m_endOfInputId] = ParsingAction(ParsingAction::Type::ACCEPT);
+        }
+        else
+        {
+            // No lookahead means any terminal
+            const ParsingAction reduceAction(ParsingAction::Type::REDUCE, item.rule.numRule);
+            if(item.lookaheads.empty())
+            {
+                for(size_t id = 0; id < m_nbTerminals; id++)
+                    if(!actions[id].isShiftOrAccept())
+                        actions[id] = reduceAction;
+            }
+            else
+            {
+                for(const auto & terminal : item.lookaheads)
+                    if(!actions[terminal.id].isShiftOrAccept())
+                        actions[terminal.id] = reduceAction;
+            }
+        }
+    }
+
+    // Default action is the most frequent reduce (the first rule on a tie).
+    // A state with no other action is consistent : it reduces whatever the next terminal.
+    std::map<int, size_t> nbReducesByRule;
+    bool hasShiftOrAccept = false;
+    for(size_t id = 0; id < m_nbTerminals; id++)
+    {
+        if(actions[id].getType() == ParsingAction::Type::REDUCE)
+            nbReducesByRule[actions[id].getNumRule()]++;
+        else if(actions[id].isShiftOrAccept())
+            hasShiftOrAccept = true;
+    }
+
+    auto defaultReduce = std::max_element(nbReducesByRule.begin(), nbReducesByRule.end(), [](const auto & a, const auto & b) { return a.second < b.second; });
+    if(defaultReduce != nbReducesByRule.end())
+        m_defaultActions[state.numState] = ParsingAction(ParsingAction::Type::REDUCE, defaultReduce->first);
+
+    m_isConsistent[state.numState] = !hasShiftOrAccept && nbReducesByRule.size() == 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ParseTable::bypassUnitRules(void)
+{
+    // Going to a consistent state reducing 'A ::= <B>' on <B> is like going straight on <A> :
+    // the state is popped right away & the value left untouched. Chains are bounded as grammar cycles could loop.
+    const size_t nbStates = m_isConsistent.size();
+    for(size_t numState = 0; numState < nbStates; numState++)
+    {
+        for(size_t id = 0; id < m_nbIntermediates; id++)
+        {
+            int & nextState = m_gotos[numState * m_nbIntermediates + id];
+            for(size_t length = 0; (nextState != NO_STATE) && (length < m_nbIntermediates); length++)
+            {
+                if(!m_isConsistent[nextState])
+                    break;
+
+                const Rule & rule = getRule(m_defaultActions[nextState].getNumRule());
+                if(!rule.isUnitCopy)
+                    break;
+
+                nextState = m_gotos[numState * m_nbIntermediates + rule.intermediate.id];
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ParsingAction ParseTable::getAction(int numState, const Symbol & terminal) const
+{
+    return m_actions[numState * m_nbTerminals + terminal.id];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ParsingAction ParseTable::getDefaultAction(int numState) const
+{
+    return m_defaultActions[numState];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ParsingAction ParseTable::getTakenAction(int numState, const Symbol & terminal) const
+{
+    // Errors are left to the default action
+    const ParsingAction action = getAction(numState, terminal);
+    if(action.getType() == ParsingAction::Type::ERROR || m_isConsistent[numState])
+        return m_defaultActions[numState];
+
+    return action;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ParseTable::getGoto(int numState, const Symbol & intermediate) const
+{
+    return m_gotos[numState * m_nbIntermediates + intermediate.id];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ParseTable::getReduceGoto(int numState, const Rule & rule) const
+{
+    // Walk back the paths spelling the rule symbols to find the states the reduce may expose
+    std::vector<int> states(1, numState);
+    for(auto symbol = rule.symbols.rbegin(); symbol != rule.symbols.rend(); ++symbol)
+    {
+        std::vector<int> predecessors;
+        for(int state : states)
+        {
+            if(m_accessingSymbols[state] == nullptr || *m_accessingSymbols[state] != *symbol)
+                continue;
+
+            for(int predecessor : m_predecessors[state])
+                if(std::find(predecessors.begin(), predecessors.end(), predecessor) == predecessors.end())
+                    predecessors.push_back(predecessor);
+        }
+        states.swap(predecessors);
+    }
+
+    // The goto is known when all those states agree
+    int nextState = NO_STATE;
+    for(int state : states)
+    {
+        const int gotoState = getGoto(state, rule.intermediate);
+        if(gotoState == NO_STATE || (nextState != NO_STATE && gotoState != nextState))
+            return NO_STATE;
+
+        nextState = gotoState;
+    }
+
+    return nextState;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ParseTable::isConsistent(int numState) const
+{
+    return m_isConsistent[numState];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const Rule & ParseTable::getRule(int numRule) const
+{
+    return *m_rulesByNum[numRule];
+}
@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef PARSE_TABLE_H
+#define PARSE_TABLE_H
+#include "ParsingAction.h"
+#include "Symbol.h"
+
+#include <vector>
+#include <cstddef>
+
+class Grammar;
+class Rule;
+class ParserState;
+
+// Dense ACTION & GOTO tables of a parser, computed once all its states are generated.
+// Rows are indexed by state number, columns by terminal id (end of input included) or intermediate id.
+// The most frequent reduce of a state is its default action, to be taken on errors too.
+// Gotos to a state only reducing a unit rule copying its value lead to the goto of that rule instead.
+// States predecessors tell which states a reduce may expose, hence if its goto is statically known.
+class ParseTable
+{
+    public :
+        static const int NO_STATE = -1;
+
+    public :
+        ParseTable(void) = default;
+        ParseTable(const Grammar & grammar, size_t nbStates);
+
+        void addState(const ParserState & state);
+        void bypassUnitRules(void);
+
+        ParsingAction getAction(int numState, const Symbol & terminal) const;
+        ParsingAction getDefaultAction(int numState) const;
+        ParsingAction getTakenAction(int numState, const Symbol & terminal) const;
+        int           getGoto  (int numState, const Symbol & intermediate) const;
+        int           getReduceGoto(int numState, const Rule & rule) const;
+        bool          isConsistent(int numState) const;
+        const Rule &  getRule  (int numRule) const;
+
+    private :
+        size_t                      m_nbTerminals     = 0;
+        size_t                      m_nbIntermediates = 0;
+        int                         m_endOfInputId    = -1;
+
+        std::vector<ParsingAction>  m_actions;
+        std::vector<ParsingAction>  m_defaultActions;
+        std::vector<bool>           m_isConsistent;
+        std::vector<int>            m_gotos;
+        std::vector<std::vector<int>> m_predecessors;
+        std::vector<const Symbol *> m_accessingSymbols;
+        std::vector<const Rule *>   m_rulesByNum;
+};
+
+#endif /* PARSE_TABLE_H */
@@ -8,73 +8,144 @@
 #include "Grammar.h"
 #include "config/Options.h"
 #include "printer/PrettyPrinters.h"
+#include "utils/Parallel.h"
 
 #include <string>
 #include <algorithm>
 #include <iterator>
 #include <iomanip>
 #include <sstream>
+#include <unordered_set>
+#include <vector>
+#include <memory>
 
 ////////////////////////////////////////////////////////////////////////////////
 Parser::Parser(const Grammar & grammar, Options & options)
-: m_grammar(grammar), m_options(options)
+: m_grammar(grammar), m_options(options), m_states(ArenaAllocator<ParserState::Ptr>(m_arena))
 {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Parser::generateStates(void)
 {
-    addNewState(createStartState());
-    for(auto & state : m_states)
+    const size_t nbWorkers = nb_workers(m_options.nbJobs);
+    while(m_workspaces.size() < nbWorkers)
+        m_workspaces.push_back(std::make_unique<Workspace>());
+
+    addOrMergeState(createStartState());
+    closePendingStates(m_states.size());
+
+    // States are processed level by level, new states and those whose lookaheads grew
+    // after a merge making the next level
+    std::vector<States::iterator> level;
+    std::vector<Successors> successors;
+    while(!m_pendingStates.empty())
     {
-        auto allSuccessors = createSuccessorStates(state);
+        level.swap(m_pendingStates);
+        m_pendingStates.clear();
+        for(auto stateIt : level)
+            m_isPending[(*stateIt)->numState] = false;
+
+        // Successor kernels of a level are built concurrently...
+        successors.resize(level.size());
+        parallel_for(nbWorkers, level.size(), [&](size_t numWorker, size_t i)
+        {
+            successors[i] = this->createSuccessorStates(*level[i], *m_workspaces[numWorker]);
+        });
 
-        for(auto & successorPair : allSuccessors)
+        // ...but merged in order, so that states are numbered the same whatever the number of workers
+        const size_t nbStates = m_states.size();
+        for(size_t i = 0; i < level.size(); i++)
         {
-            auto & successor = addNewState(std::move(successorPair.second));
-            state->assignSuccessors(successorPair.first, *successor);
+            for(auto & successorPair : successors[i])
+            {
+                auto & successor = addOrMergeState(std::move(successorPair.second));
+                (*level[i])->assignSuccessors(successorPair.first, *successor);
+            }
         }
+
+        closePendingStates(m_states.size() - nbStates);
+
+        successors.clear();
+        for(auto & workspace : m_workspaces)
+            workspace->kernels.reset();
     }
+
+    removeUnreachableStates();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-ParserState::Ptr & Parser::addNewState(ParserState::Ptr && state)
+ParserState::Ptr & Parser::addOrMergeState(ParserState::Ptr && kernel)
 {
-    state->numState = m_states.size();
-    state->close(m_grammar);
+    // Only states sharing the same kernel signature are candidates to the merge,
+    // comparing kernels is enough as closure only depends on them
+    const size_t signature = kernel->getKernelSignature();
+    auto candidates = m_statesIndex.equal_range(signature);
+    auto mergeableIt = std::find_if(candidates.first, candidates.second, [&kernel](const auto & candidate) -> bool { return (*candidate.second)->isMergeableWith(kernel); });
+    if(mergeableIt == candidates.second)
+    {
+        kernel->numState = m_states.size();
 
-    return addOrMergeState(std::forward<ParserState::Ptr>(state));
+        auto newStateIt = m_states.insert(m_states.end(), std::forward<ParserState::Ptr>(kernel));
+        m_statesIndex.emplace(signature, newStateIt);
+        m_pendingStates.push_back(newStateIt);
+        m_isPending.push_back(true);
+
+        return *newStateIt;
+    }
+
+    // Lookaheads merged into the kernel have to be propagated to the closure and to the successors
+    auto stateIt = mergeableIt->second;
+    auto & state = **stateIt;
+    if(state.merge(kernel) && !m_isPending[state.numState])
+    {
+        m_pendingStates.push_back(stateIt);
+        m_isPending[state.numState] = true;
+    }
+
+    return *stateIt;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-ParserState::Ptr & Parser::addOrMergeState(ParserState::Ptr && newState)
+void Parser::closePendingStates(size_t nbNewStates)
 {
-    auto mergeableSate = std::find_if(m_states.begin(), m_states.end(), [&newState](const auto & state) -> bool { return state->isMergeableWith(newState); });
-    if(mergeableSate == m_states.end())
-        return *m_states.insert(mergeableSate, std::forward<ParserState::Ptr>(newState));
-    else
+    // Pending states are either new (the last ones), or already closed and only getting more lookaheads
+    const int firstNewState = m_states.size() - nbNewStates;
+    parallel_for(nb_workers(m_options.nbJobs), m_pendingStates.size(), [&](size_t numWorker, size_t numPendingState)
     {
-        (*mergeableSate)->merge(newState);
+        auto & state = **m_pendingStates[numPendingState];
+        if(state.numState >= firstNewState)
+            state.moveItemsTo(m_workspaces[numWorker]->states);
 
-        // Recusively propagate lookahead of first item to all successors
-        mergeSucessorsLookahead(*(*mergeableSate), newState->items.begin()->lookaheads);
-
-        return *mergeableSate;
-    }
+        state.close(m_grammar);
+    });
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void Parser::mergeSucessorsLookahead(ParserState & state, SymbolSet & lookaheads)
+void Parser::removeUnreachableStates(void)
 {
-    auto firstItemIt = state.items.begin();
-
-    if(firstItemIt != state.items.end())
+    // A state processed again may have been redirected to new successors
+    std::unordered_set<const ParserState *> reachableStates = { m_states.front().get() };
+    std::vector<const ParserState *> statesToVisit = { m_states.front().get() };
+    while(!statesToVisit.empty())
     {
-        firstItemIt->lookaheads.insert(lookaheads.begin(), lookaheads.end());
+        const ParserState * state = statesToVisit.back();
+        statesToVisit.pop_back();
 
-        if(firstItemIt->isShift() && firstItemIt->nextState)
-            mergeSucessorsLookahead(*(firstItemIt->nextState), lookaheads);
+        for(const auto & item : state->items)
+            if(item.nextState != nullptr && reachableStates.insert(item.nextState).second)
+                statesToVisit.push_back(item.nextState);
     }
+
+    if(reachableStates.size() == m_states.size())
+        return;
+
+    m_states.remove_if([&reachableStates](const auto & state) { return reachableStates.count(state.get()) == 0; });
+    m_statesIndex.clear();
+
+    int numState = 0;
+    for(auto & state : m_states)
+        state->numState = numState++;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -84,12 +155,28 @@ void Parser::check(void)
         state->check(errors);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void Parser::computeTable(void)
+{
+    m_table = ParseTable(m_grammar, m_states.size());
+    for(const auto & state : m_states)
+        m_table.addState(*state);
+
+    m_table.bypassUnitRules();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 const Parser::States & Parser::getStates(void) const
 {
     return m_states;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+const ParseTable & Parser::getTable(void) const
+{
+    return m_table;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 const Grammar & Parser::getGrammar(void) const
 {
@@ -7,10 +7,15 @@
 #ifndef PARSER_H
 #define PARSER_H
 #include "ParserState.h"
+#include "ParseTable.h"
 #include "Errors.h"
+#include "utils/Arena.h"
 
 #include <list>
+#include <memory>
+#include <vector>
 #include <cstdint>
+#include <map>
 #include <unordered_map>
 
 class Grammar;
@@ -19,16 +24,28 @@ struct Options;
 class Parser
 {
     public :
-        using States = std::list<ParserState::Ptr>;
+        using States = std::list<ParserState::Ptr, ArenaAllocator<ParserState::Ptr>>;
+        using StatesIndex = std::unordered_multimap<size_t, States::iterator>;
+        using Successors = std::map<Symbol, ParserState::Ptr>;  // Ordered, numbering states the same on any platform
+
+        // Memory of a worker thread : its states are kept with the parser,
+        // their kernels being built aside as most of them end up merged into existing states
+        struct Workspace
+        {
+            Arena states;
+            Arena kernels;
+        };
 
     public :
         Parser(const Grammar & grammar, Options & options);
         virtual ~Parser(void) = default;
 
-        void generateStates(void);
+        virtual void generateStates(void);
         void check(void);
+        void computeTable(void);
 
         const States & getStates(void) const;
+        const ParseTable & getTable(void) const;
         const Grammar & getGrammar(void) const;
         const Options & getOptions(void) const;
 
@@ -36,20 +53,20 @@ class Parser
         Errors<GeneratingError> errors;
 
     protected :
-        ParserState::Ptr & addNewState(ParserState::Ptr && state);
-        ParserState::Ptr & addOrMergeState(ParserState::Ptr && state);
-        void mergeSucessorsLookahead(ParserState & state, SymbolSet & lookaheads);
+        ParserState::Ptr & addOrMergeState(ParserState::Ptr && kernel);
+        void closePendingStates(size_t nbNewStates);
+        void removeUnreachableStates(void);
 
         virtual ParserState::Ptr createStartState(void) = 0;
-        virtual std::unordered_map<std::string, ParserState::Ptr> createSuccessorStates(const ParserState::Ptr & state) = 0;
+        virtual Successors createSuccessorStates(const ParserState::Ptr & state, Workspace & workspace) = 0;
 
         template<typename StateType>
-        static StateType & fetchOrInsertState(std::unordered_map<std::string, ParserState::Ptr> & successors, const std::string & name)
+        StateType & fetchOrInsertState(Successors & successors, const Symbol & symbol, Workspace & workspace)
         {
-            auto & statePtr = successors[name];
+            auto & statePtr = successors[symbol];
 
             if(!statePtr)
-                statePtr = std::make_unique<StateType>();
+                statePtr = workspace.states.create<StateType>(workspace.kernels);
 
             return *reinterpret_cast<StateType *>(statePtr.get());
         }
@@ -57,7 +74,15 @@ class Parser
         const Grammar & m_grammar;
         Options &       m_options;
 
-        States          m_states;
+        // States, their items and lookaheads are all released at once with the parser
+        Arena                                   m_arena;
+        std::vector<std::unique_ptr<Workspace>> m_workspaces;
+        States                                  m_states;
+        StatesIndex                             m_statesIndex;
+        ParseTable                              m_table;
+
+        std::vector<States::iterator> m_pendingStates;
+        std::vector<bool>             m_isPending;
 };
 
 #endif /* PARSER_H */
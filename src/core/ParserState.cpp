@@ -10,6 +10,28 @@
 
 #include <sstream>
 #include <algorithm>
+#include <vector>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+ParserState::ParserState(Arena & arena)
+: items(ArenaAllocator<Item>(arena))
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ParserState::moveItemsTo(Arena & arena)
+{
+    if(items.get_allocator().arena == &arena)
+        return;
+
+    ItemList movedItems{ArenaAllocator<Item>(arena)};
+    movedItems.reserve(items.size());
+    for(auto & item : items)
+        movedItems.push_back(std::move(item));
+
+    items = std::move(movedItems);
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 bool ParserState::contains(const Item & item) const
@@ -18,22 +40,35 @@ bool ParserState::contains(const Item & item) const
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ParserState::assignSuccessors(const std::string & nextSymbol, ParserState & nextState)
+void ParserState::assignSuccessors(const Symbol & nextSymbol, ParserState & nextState)
 {
     for(auto & item : items)
         if(item.isNextSymbolEqualTo(nextSymbol))
             item.nextState = &nextState;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+size_t ParserState::getKernelSignature(void) const
+{
+    // Items are summed up so that the signature doesn't depend on their order
+    size_t signature = 0;
+    for(const auto & item : items)
+        if(item.isKernel())
+            signature += item.getCoreHash();
+
+    return signature;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ParserState::check(Errors<GeneratingError> & errors) const
 {
-    int                 nbReduceRules = 0;
-    std::stringstream   reduceRulesError;
-    int                 nbAcceptRules = 0;
-    std::stringstream   acceptRulesError;
+    std::vector<const Item *>   reduceItems;
+    bool                        reduceConflict = false;
+    std::stringstream           reduceRulesError;
+    int                         nbAcceptRules = 0;
+    std::stringstream           acceptRulesError;
 
-    reduceRulesError << "bnf2c can't handle parser state with multiple reduce actions" << std::endl;
+    reduceRulesError << "bnf2c can't handle parser state with multiple reduce actions on the same lookahead" << std::endl;
     acceptRulesError << "bnf2c can't handle parser state with multiple accept actions" << std::endl;
 
     for(const Item & item : items)
@@ -43,7 +78,11 @@ void ParserState::check(Errors<GeneratingError> & errors) const
         {
             if(item.rule.numRule > 1)
             {
-                nbReduceRules++;
+                // Reduce items only conflict if they share a lookahead (no lookahead means any terminal)
+                for(const Item * reduceItem : reduceItems)
+                    reduceConflict |= item.lookaheads.empty() || reduceItem->lookaheads.empty() || item.lookaheads.intersects(reduceItem->lookaheads);
+
+                reduceItems.push_back(&item);
                 reduceRulesError << item << std::endl;
             }
             else
@@ -55,69 +94,18 @@ void ParserState::check(Errors<GeneratingError> & errors) const
     }
 
     // Check for errors
-    if(nbReduceRules > 1)
+    if(reduceConflict)
         errors.list.push_back(GeneratingError({reduceRulesError.str()}));
     if(nbAcceptRules > 1)
         errors.list.push_back(GeneratingError({acceptRulesError.str()}));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-ParsingAction ParserState::getAction(const std::string & terminal, const std::string & endOfInputToken) const
+const ParserState * ParserState::getGoto(const Symbol & intermediate) const
 {
-    ParsingAction action = { ParsingAction::Type::ERROR };
-
     for(const auto & item : items)
-    {
-        if(item.isShift())
-        {
-            // Shift rule
-            if(item.dottedSymbol->name == terminal)
-            {
-                action.type = ParsingAction::Type::SHIFT;
-                action.shiftNextState = item.nextState;
-                break;
-            }
-        }
-        if(item.isReduce())
-        {
-            // Reduce rule
-            if(item.rule.numRule > 1 && item.isTerminalInLookaheads(terminal))
-            {
-                action.type = ParsingAction::Type::REDUCE;
-                action.reduceRule = &item.rule;
-            }
-            // Accept rule
-            else if(terminal == endOfInputToken && item.rule.numRule == 1)
-            {
-                action.type = ParsingAction::Type::ACCEPT;
-                action.reduceRule = nullptr;
-                break;
-            }
-        }
-    }
-
-    return action;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-const ParserState * ParserState::getGoto(const std::string & intermediate) const
-{
-    for(const auto & item : items)
-        if(item.isShift() && item.dottedSymbol->isIntermediate() && item.dottedSymbol->name == intermediate)
+        if(item.isShift() && *item.dottedSymbol == intermediate)
             return item.nextState;
 
     return nullptr;
 }
-
-////////////////////////////////////////////////////////////////////////////////
-bool ParserState::isSameActionForAllTerminals(const Grammar & grammar, const std::string & endOfInputToken) const
-{
-    const auto firstAction = getAction(endOfInputToken, endOfInputToken);
-
-    for(const auto & terminal :grammar.terminals)
-        if(getAction(terminal, endOfInputToken) != firstAction)
-            return false;
-
-    return true;
-}
-
@@ -8,36 +8,37 @@
 #define PARSERSTATE_H
 #include "Item.h"
 #include "Errors.h"
-#include "ParsingAction.h"
+#include "utils/Arena.h"
 
 #include <memory>
-#include <list>
+#include <vector>
 
 class Grammar;
 
 class ParserState
 {
     public :
-        using Ptr = std::unique_ptr<ParserState>;
-        using ItemList = std::list<Item>;
+        using Ptr = std::unique_ptr<ParserState, Arena::Deleter>;
+        using ItemList = std::vector<Item, ArenaAllocator<Item>>;
 
     public :
+        ParserState(Arena & arena);
         virtual ~ParserState(void) = default;
 
+        void moveItemsTo(Arena & arena);
         bool contains(const Item & item) const;
-        void assignSuccessors(const std::string & nextSymbol, ParserState & nextState);
+        void assignSuccessors(const Symbol & nextSymbol, ParserState & nextState);
         virtual void close(const Grammar & grammar) = 0;
         virtual bool isMergeableWith(const Ptr & state) = 0;
-        virtual void merge(Ptr & state) { /* By default, do nothing */ }
+        virtual bool merge(const Ptr & state) { return false; /* By default, do nothing */ }
+        virtual size_t getKernelSignature(void) const;
 
         void check(Errors<GeneratingError> & errors) const;
 
-        ParsingAction getAction(const std::string & terminal, const std::string & endOfInputToken) const;
-        const ParserState * getGoto(const std::string & intermediate) const;
-
-        bool isSameActionForAllTerminals(const Grammar & grammar, const std::string & endOfInputToken) const;
+        const ParserState * getGoto(const Symbol & intermediate) const;
 
     public :
+        // Items of a state are contiguous, and live in the arena of their parser
         ItemList items;
         int      numState;
 };
@@ -7,28 +7,40 @@
 #ifndef PARSING_ACTION_H
 #define PARSING_ACTION_H
 #include <functional>
+#include <cstdint>
 
-class Rule;
-class ParserState;
-
-struct ParsingAction
+// Parsing action encoded as an integer : the action type in the lowest bits,
+// and the next state (SHIFT) or the reduced rule number (REDUCE) above.
+class ParsingAction
 {
-    enum class Type
-    {
-        SHIFT,
-        REDUCE,
-        ACCEPT,
-        ERROR
-    } type;
-
-    union 
-    {
-        const Rule * reduceRule;
-        const ParserState * shiftNextState;
-    };
-
-    bool operator ==(const ParsingAction & action) const;
-    bool operator !=(const ParsingAction & action) const;
+    public :
+        enum class Type
+        {
+            SHIFT,
+            REDUCE,
+            ACCEPT,
+            ERROR
+        };
+
+        using Code = std::int32_t;
+        static const int TYPE_BITS = 2;
+
+    public :
+        ParsingAction(void) : ParsingAction(Type::ERROR) {}
+        ParsingAction(Type type, int value = 0) : m_code((value << TYPE_BITS) | static_cast<Code>(type)) {}
+
+        Type getType(void)      const { return static_cast<Type>(m_code & ((1 << TYPE_BITS) - 1)); }
+        int  getNextState(void) const { return m_code >> TYPE_BITS; }
+        int  getNumRule(void)   const { return m_code >> TYPE_BITS; }
+        Code getCode(void)      const { return m_code; }
+
+        bool isShiftOrAccept(void) const { return getType() == Type::SHIFT || getType() == Type::ACCEPT; }
+
+        bool operator ==(const ParsingAction & action) const { return m_code == action.m_code; }
+        bool operator !=(const ParsingAction & action) const { return m_code != action.m_code; }
+
+    private :
+        Code m_code;
 };
 
 namespace std {
@@ -38,11 +50,10 @@ struct hash<ParsingAction>
 {
     size_t operator()(const ParsingAction & action) const
     {
-        return ((size_t) action.type) ^ ((size_t) action.reduceRule);
+        return std::hash<ParsingAction::Code>()(action.getCode());
     }
 };
 
 }
 
 #endif /* PARSING_ACTION_H */
-
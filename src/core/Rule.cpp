@@ -7,8 +7,8 @@
 #include "Rule.h"
 
 ////////////////////////////////////////////////////////////////////////////////
-Rule::Rule(const std::string & name)
-: name(name), numRule(-1)
+Rule::Rule(const Symbol & intermediate)
+: intermediate(intermediate), numRule(-1)
 {
 }
 
@@ -24,19 +24,13 @@ void Rule::addSymbol(Symbol && symbol)
     symbols.push_back(symbol);
 }
 
-////////////////////////////////////////////////////////////////////////////////
-SymbolList Rule::remainingSymbolsAfter(SymbolList::const_iterator symbol) const
-{
-    return { symbol + 1, symbols.end() };
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 bool Rule::operator ==(const Rule & rule) const
 {
     if(&rule == this)
        return true;
 
-    return (name == rule.name) && (symbols == rule.symbols);
+    return (intermediate == rule.intermediate) && (symbols == rule.symbols);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -14,21 +14,20 @@ class Rule
 {
     public :
         Rule(void) = default;
-        Rule(const std::string & name);
+        Rule(const Symbol & intermediate);
 
         void addSymbol(const Symbol & symbol);
         void addSymbol(Symbol && symbol);
 
-        SymbolList remainingSymbolsAfter(SymbolList::const_iterator symbol) const;
-
         bool operator ==(const Rule & rule) const;
         bool operator !=(const Rule & rule) const;
 
     public :
-        std::string name;
+        Symbol      intermediate;
         SymbolList  symbols;
         std::string action;
         int         numRule = -1;
+        bool        isUnitCopy = false; // Single intermediate whose value is copied as is ($$ = $1, same type)
 };
 
 #endif /* RULE_H */
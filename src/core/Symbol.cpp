@@ -12,7 +12,7 @@ bool Symbol::operator ==(const Symbol & symbol) const
     if(&symbol == this)
        return true;
 
-    return (type == symbol.type) && (name == symbol.name);
+    return (type == symbol.type) && (id == symbol.id);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -21,3 +21,11 @@ bool Symbol::operator !=(const Symbol & symbol) const
     return !operator ==(symbol);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool Symbol::operator <(const Symbol & symbol) const
+{
+    if(type != symbol.type)
+        return type == Type::TERMINAL;
+
+    return id < symbol.id;
+}
@@ -20,13 +20,15 @@ struct Symbol
     };
 
     Type        type;
-    std::string name;
+    int         id;     // Dense index among symbols of the same type, given by the grammar
+    std::string name;   // Only used to print the symbol
 
     bool isTerminal(void)     const { return type == Type::TERMINAL; }
     bool isIntermediate(void) const { return type == Type::INTERMEDIATE; }
 
     bool operator ==(const Symbol & symbol) const;
     bool operator !=(const Symbol & symbol) const;
+    bool operator <(const Symbol & symbol) const;   // Terminals first, then by id
 };
 
 using SymbolList = std::vector<Symbol>;
@@ -39,7 +41,7 @@ struct hash<Symbol>
 {
     size_t operator()(const Symbol & symbol) const
     {
-        return (size_t) symbol.type + std::hash<std::string>()(symbol.name);
+        return ((size_t) symbol.id << 1) + (size_t) symbol.type;
     }
 };
 
@@ -0,0 +1,282 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#include "TerminalSet.h"
+#include "utils/Algos.h"
+
+#include <algorithm>
+#include <utility>
+
+// Operations on two sets are done word by word in plain loops over the
+// common words, so that the compiler is free to vectorize them.
+
+////////////////////////////////////////////////////////////////////////////////
+TerminalSet::Iterator::Iterator(const TerminalSet & set, size_t id)
+: m_set(set), m_id(id)
+{
+    moveToNextTerminal();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TerminalSet::Iterator::reference TerminalSet::Iterator::operator *(void) const
+{
+    return (*m_set.m_terminals)[m_id];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TerminalSet::Iterator::pointer TerminalSet::Iterator::operator->(void) const
+{
+    return &(*m_set.m_terminals)[m_id];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TerminalSet::Iterator & TerminalSet::Iterator::operator++(void)
+{
+    m_id++;
+    moveToNextTerminal();
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TerminalSet::Iterator TerminalSet::Iterator::operator++(int)
+{
+    Iterator it(*this);
+    ++(*this);
+    return it;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TerminalSet::Iterator::moveToNextTerminal(void)
+{
+    const size_t nbBits = m_set.nbBits();
+
+    while(m_id < nbBits)
+    {
+        // Skip all remaining bits of the current word at once
+        const Word remainingBits = m_set.words()[m_id / WORD_BITS] >> (m_id % WORD_BITS);
+        if(remainingBits != 0)
+        {
+            m_id += __builtin_ctzll(remainingBits);
+            return;
+        }
+
+        m_id = (m_id / WORD_BITS + 1) * WORD_BITS;
+    }
+
+    m_id = nbBits;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TerminalSet::TerminalSet(const SymbolList & terminals)
+: m_terminals(&terminals)
+{
+    resize((terminals.size() + WORD_BITS - 1) / WORD_BITS);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TerminalSet::TerminalSet(const SymbolList & terminals, const Symbol & terminal)
+: TerminalSet(terminals)
+{
+    insert(terminal);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TerminalSet::TerminalSet(const TerminalSet & terminals)
+{
+    *this = terminals;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TerminalSet::TerminalSet(TerminalSet && terminals) noexcept
+{
+    *this = std::move(terminals);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TerminalSet & TerminalSet::operator =(const TerminalSet & terminals)
+{
+    if(&terminals == this)
+        return *this;
+
+    m_terminals = terminals.m_terminals;
+    m_heapWords.reset();
+    m_nbWords = 0;
+    resize(terminals.m_nbWords);
+    std::copy_n(terminals.words(), m_nbWords, words());
+
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TerminalSet & TerminalSet::operator =(TerminalSet && terminals) noexcept
+{
+    // Only heap words can be stolen
+    if(!terminals.m_heapWords)
+        return *this = static_cast<const TerminalSet &>(terminals);
+
+    m_terminals = terminals.m_terminals;
+    m_nbWords   = terminals.m_nbWords;
+    m_heapWords = std::move(terminals.m_heapWords);
+    terminals.m_nbWords = 0;
+
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TerminalSet::resize(size_t nbWords)
+{
+    // Sets only grow, new words are empty
+    if(nbWords <= m_nbWords)
+        return;
+
+    if(nbWords > NB_INLINE_WORDS)
+    {
+        std::unique_ptr<Word[]> heapWords(new Word[nbWords]());
+        std::copy_n(words(), m_nbWords, heapWords.get());
+        m_heapWords = std::move(heapWords);
+    }
+    else
+        std::fill(m_inlineWords + m_nbWords, m_inlineWords + nbWords, 0);
+
+    m_nbWords = nbWords;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TerminalSet::insert(const Symbol & terminal)
+{
+    // A set built without terminals list grows up to the inserted terminal
+    resize(terminal.id / WORD_BITS + 1);
+
+    Word & word = words()[terminal.id / WORD_BITS];
+    const Word bit = Word(1) << (terminal.id % WORD_BITS);
+
+    if(word & bit)
+        return false;
+
+    word |= bit;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TerminalSet::insert(const TerminalSet & terminals)
+{
+    // An empty set built without terminals list takes the one of the inserted set
+    if(m_nbWords < terminals.m_nbWords)
+    {
+        m_terminals = terminals.m_terminals;
+        resize(terminals.m_nbWords);
+    }
+
+    Word *       thisWords = words();
+    const Word * setWords  = terminals.words();
+
+    Word changedBits = 0;
+    for(size_t i = 0; i < terminals.m_nbWords; i++)
+    {
+        changedBits |= setWords[i] & ~thisWords[i];
+        thisWords[i] |= setWords[i];
+    }
+
+    return changedBits != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TerminalSet::contains(const Symbol & terminal) const
+{
+    return (size_t) terminal.id < nbBits() && test(terminal.id);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TerminalSet::isSubsetOf(const TerminalSet & terminals) const
+{
+    const size_t nbCommonWords = std::min(m_nbWords, terminals.m_nbWords);
+    const Word * thisWords = words();
+    const Word * setWords  = terminals.words();
+
+    Word extraBits = 0;
+    for(size_t i = 0; i < nbCommonWords; i++)
+        extraBits |= thisWords[i] & ~setWords[i];
+    for(size_t i = nbCommonWords; i < m_nbWords; i++)
+        extraBits |= thisWords[i];
+
+    return extraBits == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TerminalSet::intersects(const TerminalSet & terminals) const
+{
+    const size_t nbCommonWords = std::min(m_nbWords, terminals.m_nbWords);
+    const Word * thisWords = words();
+    const Word * setWords  = terminals.words();
+
+    Word commonBits = 0;
+    for(size_t i = 0; i < nbCommonWords; i++)
+        commonBits |= thisWords[i] & setWords[i];
+
+    return commonBits != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TerminalSet::empty(void) const
+{
+    const Word * thisWords = words();
+
+    Word allBits = 0;
+    for(size_t i = 0; i < m_nbWords; i++)
+        allBits |= thisWords[i];
+
+    return allBits == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+size_t TerminalSet::size(void) const
+{
+    const Word * thisWords = words();
+
+    size_t nbTerminals = 0;
+    for(size_t i = 0; i < m_nbWords; i++)
+        nbTerminals += __builtin_popcountll(thisWords[i]);
+
+    return nbTerminals;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+size_t TerminalSet::hash(void) const
+{
+    // Trailing empty words are skipped, so that equal sets have the same hash
+    const Word * thisWords = words();
+
+    size_t hash = 0;
+    for(size_t i = 0; i < m_nbWords; i++)
+        if(thisWords[i] != 0)
+            hash = hash_combine(hash, hash_combine(i, std::hash<Word>()(thisWords[i])));
+
+    return hash;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TerminalSet::operator ==(const TerminalSet & terminals) const
+{
+    return isSubsetOf(terminals) && terminals.isSubsetOf(*this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TerminalSet::operator !=(const TerminalSet & terminals) const
+{
+    return !(*this == terminals);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TerminalSet::Iterator TerminalSet::begin(void) const
+{
+    return Iterator(*this, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TerminalSet::Iterator TerminalSet::end(void) const
+{
+    return Iterator(*this, nbBits());
+}
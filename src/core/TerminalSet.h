@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef TERMINAL_SET_H
+#define TERMINAL_SET_H
+#include "Symbol.h"
+
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+
+// Set of terminals stored as a bitset indexed by terminal id.
+// The terminals list (indexed by id) is only used to iterate over symbols.
+// Small sets are stored inline, so that items don't need any extra allocation.
+class TerminalSet
+{
+    public :
+        using Word = std::uint64_t;
+        static const size_t WORD_BITS = 64;
+        static const size_t NB_INLINE_WORDS = 4;
+
+        class Iterator
+        {
+            public :
+                using iterator_category = std::forward_iterator_tag;
+                using value_type        = Symbol;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = const Symbol *;
+                using reference         = const Symbol &;
+
+                Iterator(const TerminalSet & set, size_t id);
+
+                reference  operator *(void) const;
+                pointer    operator->(void) const;
+                Iterator & operator++(void);
+                Iterator   operator++(int);
+
+                bool operator ==(const Iterator & it) const { return m_id == it.m_id; }
+                bool operator !=(const Iterator & it) const { return m_id != it.m_id; }
+
+            private :
+                void moveToNextTerminal(void);
+
+                const TerminalSet & m_set;
+                size_t              m_id;
+        };
+
+    public :
+        TerminalSet(void) = default;
+        TerminalSet(const SymbolList & terminals);
+        TerminalSet(const SymbolList & terminals, const Symbol & terminal);
+        TerminalSet(const TerminalSet & terminals);
+        TerminalSet(TerminalSet && terminals) noexcept;
+        TerminalSet & operator =(const TerminalSet & terminals);
+        TerminalSet & operator =(TerminalSet && terminals) noexcept;
+
+        bool insert(const Symbol & terminal);
+        bool insert(const TerminalSet & terminals);
+
+        bool contains(const Symbol & terminal) const;
+        bool isSubsetOf(const TerminalSet & terminals) const;
+        bool intersects(const TerminalSet & terminals) const;
+        bool empty(void) const;
+        size_t size(void) const;
+        size_t hash(void) const;
+
+        bool operator ==(const TerminalSet & terminals) const;
+        bool operator !=(const TerminalSet & terminals) const;
+
+        Iterator begin(void) const;
+        Iterator end(void) const;
+
+    private :
+        void resize(size_t nbWords);
+
+        Word *       words(void)       { return m_heapWords ? m_heapWords.get() : m_inlineWords; }
+        const Word * words(void) const { return m_heapWords ? m_heapWords.get() : m_inlineWords; }
+        size_t nbBits(void) const { return m_nbWords * WORD_BITS; }
+        bool   test(size_t id) const { return (words()[id / WORD_BITS] >> (id % WORD_BITS)) & 1; }
+
+        const SymbolList *      m_terminals = nullptr;
+        size_t                  m_nbWords   = 0;
+        Word                    m_inlineWords[NB_INLINE_WORDS] = {};
+        std::unique_ptr<Word[]> m_heapWords;
+};
+
+#endif /* TERMINAL_SET_H */
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#include "generator/CompressedTable.h"
+
+#include <algorithm>
+#include <numeric>
+
+const int CompressedTable::NO_ROW;
+
+////////////////////////////////////////////////////////////////////////////////
+CompressedTable::CompressedTable(size_t nbColumns)
+: m_nbColumns(nbColumns)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CompressedTable::addRow(std::vector<Entry> && entries, int defaultValue)
+{
+    m_rows.push_back(std::move(entries));
+    defaults.push_back(defaultValue);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CompressedTable::pack(void)
+{
+    // First fit, densest rows first as sparse ones easily fill the remaining holes
+    std::vector<size_t> rowsOrder(m_rows.size());
+    std::iota(rowsOrder.begin(), rowsOrder.end(), 0);
+    std::stable_sort(rowsOrder.begin(), rowsOrder.end(), [this](size_t a, size_t b) { return m_rows[a].size() > m_rows[b].size(); });
+
+    base.assign(m_rows.size(), 0);
+    check.clear();
+    next.clear();
+
+    size_t firstFree = 0;
+    for(size_t numRow : rowsOrder)
+    {
+        const auto & entries = m_rows[numRow];
+        if(entries.empty())
+            continue;
+
+        // Entries can't go before the first free slot
+        size_t rowBase = firstFree > static_cast<size_t>(entries.front().first) ? firstFree - entries.front().first : 0;
+        auto fits = [&](size_t rowBase)
+        {
+            return std::all_of(entries.begin(), entries.end(), [&](const Entry & entry) { return rowBase + entry.first >= check.size() || check[rowBase + entry.first] == NO_ROW; });
+        };
+        while(!fits(rowBase))
+            rowBase++;
+
+        base[numRow] = rowBase;
+        for(const auto & entry : entries)
+        {
+            const size_t index = rowBase + entry.first;
+            if(index >= check.size())
+            {
+                check.resize(index + 1, NO_ROW);
+                next.resize(index + 1, 0);
+            }
+
+            check[index] = numRow;
+            next [index] = entry.second;
+        }
+
+        while(firstFree < check.size() && check[firstFree] != NO_ROW)
+            firstFree++;
+    }
+
+    // Any column of any row must stay inside the vectors
+    size_t size = 0;
+    for(size_t numRow = 0; numRow < m_rows.size(); numRow++)
+        size = std::max(size, base[numRow] + m_nbColumns);
+
+    check.resize(size, NO_ROW);
+    next.resize(size, 0);
+    m_rows.clear();
+}
+
@@ -0,0 +1,40 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef COMPRESSED_TABLE_H
+#define COMPRESSED_TABLE_H
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+// Sparse table compressed by row displacement (or comb vector) : all rows are
+// overlaid into a single 'next' vector, row 'r' starting at 'base[r]'.
+// Entry (r, c) is 'next[base[r] + c]' when 'check[base[r] + c] == r', 'defaults[r]' otherwise.
+class CompressedTable
+{
+    public :
+        using Entry = std::pair<int, int>; // Column & value
+
+        static const int NO_ROW = -1;
+
+    public :
+        CompressedTable(size_t nbColumns);
+
+        void addRow(std::vector<Entry> && entries, int defaultValue);
+        void pack(void);
+
+    public :
+        std::vector<int> base;
+        std::vector<int> check;
+        std::vector<int> next;
+        std::vector<int> defaults;
+
+    private :
+        size_t                          m_nbColumns;
+        std::vector<std::vector<Entry>> m_rows;
+};
+
+#endif /* COMPRESSED_TABLE_H */
@@ -0,0 +1,228 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#include "generator/DriverGenerator.h"
+
+#include <cctype>
+
+const std::string DriverGenerator::PARSE_ACTION_FUNCTION("parseAction");
+const std::string DriverGenerator::LEXER_TEMPLATE_PARAMETER("TLexer");
+const std::string DriverGenerator::VALUE_TEMPLATE_PARAMETER("TValue");
+
+////////////////////////////////////////////////////////////////////////////////
+DriverGenerator::DriverGenerator(Options & options)
+: m_options(options)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DriverGenerator::printTo(std::ostream & os) const
+{
+    printStructTo(os);
+    os << std::endl;
+    printParseLoopTo(os);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DriverGenerator::setStacksCode(Options & options)
+{
+    const std::string maxDepth = maxDepthName(options);
+
+    options.topState  = "stateStack[nbStates - 1]";
+    options.popState  = "nbStates -= <NB_STATES>;";
+    options.pushState = "{ if(nbStates == " + maxDepth + ") return " + options.errorState + "; stateStack[nbStates++] = <STATE>; }";
+
+    // Values are never deeper than states, only states pushes are checked
+    options.pushValue = "valueStack[nbValues++] = <VALUE>;";
+    options.pushToken = options.valueAsToken.replaceParam(Vars::VALUE, "valueStack[nbValues++]").replaceParam(Vars::TYPE, options.tokenType).toString() + " = <VALUE>;";
+    options.popValues = "nbValues -= <NB_VALUES>;";
+    options.getValue  = "valueStack[nbValues - <VALUE_IDX> - 1]";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string DriverGenerator::definitionName(const Options & options, const std::string & name)
+{
+    if(options.parserStruct.empty())
+        return name;
+
+    if(isTemplate(options))
+    {
+        std::string parameters = VALUE_TEMPLATE_PARAMETER;
+        if(!options.lexerType.empty())
+            parameters = LEXER_TEMPLATE_PARAMETER + ", " + parameters;
+
+        return options.parserStruct + '<' + parameters + ">::" + name;
+    }
+
+    return options.parserStruct + "::" + name;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string DriverGenerator::parseActionName(const Options & options)
+{
+    // The struct parse function is the loop, actions are taken by another member
+    if(options.parserStruct.empty())
+        return options.parseFunctionName;
+
+    return definitionName(options, PARSE_ACTION_FUNCTION);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string DriverGenerator::templateDeclaration(const Options & options)
+{
+    if(!isTemplate(options))
+        return "";
+
+    std::string declaration = "template<";
+    if(!options.lexerType.empty())
+        declaration += "typename " + LEXER_TEMPLATE_PARAMETER + ", ";
+
+    return declaration + "typename " + VALUE_TEMPLATE_PARAMETER + '>';
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string DriverGenerator::valueTypeName(const Options & options)
+{
+    return isTemplate(options) ? VALUE_TEMPLATE_PARAMETER : options.valueType;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DriverGenerator::printStructTo(std::ostream & os) const
+{
+    const std::string maxDepth   = maxDepthName(m_options);
+    const std::string exceptions = m_options.throwedExceptions.empty() ? "" : " throw(" + m_options.throwedExceptions + ")";
+
+    os << "#ifndef " << maxDepth << std::endl;
+    os << "#define " << maxDepth << " 1024" << std::endl;
+    os << "#endif" << std::endl << std::endl;
+
+    // User types are the default template arguments
+    if(isTemplate(m_options))
+    {
+        os << m_options.indent << "template<";
+        if(!m_options.lexerType.empty())
+            os << "typename " << LEXER_TEMPLATE_PARAMETER << " = " << m_options.lexerType << ", ";
+        os << "typename " << VALUE_TEMPLATE_PARAMETER << " = " << m_options.valueType << '>' << std::endl;
+    }
+    os << m_options.indent << "struct " << m_options.parserStruct << std::endl;
+    os << m_options.indent << '{' << std::endl;
+    m_options.indent++;
+
+    // Stacks
+    os << m_options.indent << m_options.stateType << " stateStack[" << maxDepth << "];" << std::endl;
+    os << m_options.indent << valueTypeName(m_options) << " valueStack[" << maxDepth << "];" << std::endl;
+    os << m_options.indent << "int nbStates;" << std::endl;
+    os << m_options.indent << "int nbValues;" << std::endl;
+    if(!m_options.lexerType.empty())
+        os << m_options.indent << lexerTypeName(m_options) << " * lexer;" << std::endl;
+    os << std::endl;
+
+    // Functions
+    os << m_options.indent << m_options.stateType << ' ' << m_options.parseFunctionName << '(';
+    if(m_options.lexerType.empty())
+        os << "void";
+    else
+        os << lexerTypeName(m_options) << " & input";
+    os << ')' << exceptions << ';' << std::endl;
+
+    os << m_options.indent << m_options.stateType << ' ' << PARSE_ACTION_FUNCTION << '(';
+    if(hasTokenParameter(m_options))
+        os << "const " << m_options.tokenType << ' ' << m_options.tokenName;
+    else
+        os << "void";
+    os << ')' << exceptions << ';' << std::endl;
+
+    // Branches are part of the parse action with compressed tables
+    if(!m_options.useCompressedTables)
+    {
+        if(m_options.useTableForBranches)
+            os << m_options.indent << "static const " << m_options.stateType << ' ' << m_options.branchFunctionName << "[];" << std::endl;
+        else
+            os << m_options.indent << m_options.stateType << ' ' << m_options.branchFunctionName << "(const " << m_options.intermediateType << " intermediate);" << std::endl;
+    }
+
+    m_options.indent--;
+    os << m_options.indent << "};" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DriverGenerator::printParseLoopTo(std::ostream & os) const
+{
+    if(isTemplate(m_options))
+        os << m_options.indent << templateDeclaration(m_options) << std::endl;
+    os << m_options.indent << m_options.stateType << ' ' << definitionName(m_options, m_options.parseFunctionName) << '(';
+    if(m_options.lexerType.empty())
+        os << "void";
+    else
+        os << lexerTypeName(m_options) << " & input";
+    os << ')';
+    if(!m_options.throwedExceptions.empty())
+        os << " throw(" << m_options.throwedExceptions << ")";
+    os << std::endl;
+    os << m_options.indent << '{' << std::endl;
+    m_options.indent++;
+
+    if(!m_options.lexerType.empty())
+        os << m_options.indent << "lexer = &input;" << std::endl;
+    os << m_options.indent << "nbStates = 0;" << std::endl;
+    os << m_options.indent << "nbValues = 0;" << std::endl;
+    os << m_options.indent << "stateStack[nbStates++] = 0;" << std::endl << std::endl;
+
+    // A computed goto parse action already goes through all tokens
+    if(!hasTokenParameter(m_options))
+        os << m_options.indent << "return " << PARSE_ACTION_FUNCTION << "();" << std::endl;
+    else
+    {
+        os << m_options.indent << "for(;;)" << std::endl;
+        os << m_options.indent << '{' << std::endl;
+        m_options.indent++;
+        os << m_options.indent << "const " << m_options.stateType << " state = " << PARSE_ACTION_FUNCTION << '(' << m_options.currentToken << ");" << std::endl;
+        os << m_options.indent << "if((state == " << m_options.errorState << ") || (state == " << m_options.acceptState << "))" << std::endl;
+        m_options.indent++;
+        os << m_options.indent << "return state;" << std::endl;
+        m_options.indent--;
+        os << m_options.indent << "if(nbStates == " << maxDepthName(m_options) << ')' << std::endl;
+        m_options.indent++;
+        os << m_options.indent << "return " << m_options.errorState << ';' << std::endl;
+        m_options.indent--;
+        os << m_options.indent << "stateStack[nbStates++] = state;" << std::endl;
+        m_options.indent--;
+        os << m_options.indent << '}' << std::endl;
+    }
+
+    m_options.indent--;
+    os << m_options.indent << '}' << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string DriverGenerator::maxDepthName(const Options & options)
+{
+    // Stacks depth can be overridden at compile time
+    std::string name;
+    for(char c : options.parserStruct)
+        name += std::isalnum(static_cast<unsigned char>(c)) ? std::toupper(static_cast<unsigned char>(c)) : '_';
+
+    return name + "_MAX_DEPTH";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string DriverGenerator::lexerTypeName(const Options & options)
+{
+    return isTemplate(options) ? LEXER_TEMPLATE_PARAMETER : options.lexerType;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool DriverGenerator::isTemplate(const Options & options)
+{
+    // A template struct can be put in a header, along with its constexpr tables
+    return !options.parserStruct.empty() && options.useConstexprTables;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool DriverGenerator::hasTokenParameter(const Options & options)
+{
+    return !options.useComputedGotos || options.useCompressedTables;
+}
@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef DRIVER_GENERATOR_H
+#define DRIVER_GENERATOR_H
+#include "config/Options.h"
+
+#include <string>
+#include <ostream>
+
+// Self-contained parser struct : states & values stacks are fixed size arrays
+// of the struct, and its parse function loops over all tokens. Generated parse
+// & branch functions become members, the struct being reentrant.
+// With constexpr tables, the struct is a template on its lexer & value types.
+class DriverGenerator
+{
+    public :
+        static const std::string PARSE_ACTION_FUNCTION;
+        static const std::string LEXER_TEMPLATE_PARAMETER;
+        static const std::string VALUE_TEMPLATE_PARAMETER;
+
+    public :
+        DriverGenerator(Options & options);
+
+        void printTo(std::ostream & os) const;
+
+        // Replace user stacks codes by the struct ones
+        static void setStacksCode(Options & options);
+
+        // Name of a generated function definition, qualified when it is a member of the struct
+        static std::string definitionName(const Options & options, const std::string & name);
+        static std::string parseActionName(const Options & options);
+
+        // Template declaration preceding a member definition (empty when the struct isn't a template)
+        static std::string templateDeclaration(const Options & options);
+        static std::string valueTypeName(const Options & options);
+
+    private :
+        void printStructTo   (std::ostream & os) const;
+        void printParseLoopTo(std::ostream & os) const;
+
+        static std::string maxDepthName(const Options & options);
+        static std::string lexerTypeName(const Options & options);
+        static bool        isTemplate(const Options & options);
+        static bool        hasTokenParameter(const Options & options);
+
+    private :
+        Options & m_options;
+};
+
+#endif /* DRIVER_GENERATOR_H */
@@ -15,7 +15,12 @@ FunctionGenerator::FunctionGenerator(Indenter & indenter, const std::string & re
 ////////////////////////////////////////////////////////////////////////////////
 void FunctionGenerator::printBeginTo(std::ostream & os) const
 {
-    os << m_indenter << m_returnType << " " << m_funcName << "(const " << m_paramType << ' ' << m_paramName << ')';
+    os << m_indenter << m_returnType << " " << m_funcName << '(';
+    if(m_paramType.empty())
+        os << "void";
+    else
+        os << "const " << m_paramType << ' ' << m_paramName;
+    os << ')';
     if(!m_exceptions.empty())
         os << " throw(" << m_exceptions << ")";
     os << std::endl;
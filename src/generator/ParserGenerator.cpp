@@ -5,22 +5,62 @@
 // License. See LICENSE for details.
 ////////////////////////////////////////////////////////////////////////////////
 #include "generator/ParserGenerator.h"
+#include "utils/Parallel.h"
+
+#include <string>
+#include <sstream>
+#include <unordered_map>
+#include <algorithm>
 
 ////////////////////////////////////////////////////////////////////////////////
-ParserGenerator::ParserGenerator(const Parser & table, const Grammar & grammar, Options & options)
+ParserGenerator::ParserGenerator(const Parser & parser, const Grammar & grammar, Options & options)
 : m_options(options),
-    m_parseFunction(m_options.indent,  m_options.stateType, m_options.parseFunctionName, m_options.tokenType, m_options.tokenName, m_options.throwedExceptions, m_options.errorState),
-    m_branchFunction(m_options.indent, m_options.stateType, m_options.branchFunctionName, m_options.intermediateType, "intermediate", "", m_options.errorState),
-    m_switchOnStates(m_options.indent, m_options.topState, m_options.defaultSwitchStatement ? "return " + m_options.errorState + ";" : "")
+    m_parseFunction(m_options.indent,  m_options.stateType, DriverGenerator::parseActionName(m_options), m_options.useComputedGotos ? "" : m_options.tokenType, m_options.tokenName, m_options.throwedExceptions, m_options.errorState),
+    m_branchFunction(m_options.indent, m_options.stateType, DriverGenerator::definitionName(m_options, m_options.branchFunctionName), m_options.intermediateType, "intermediate", "", m_options.errorState),
+    m_switchOnStates(m_options.indent, m_options.topState, m_options.defaultSwitchStatement ? "return " + m_options.errorState + ";" : ""),
+    m_profileGenerator(grammar, parser.getTable(), parser.getStates().size(), options)
 {
-    m_stateGenerators.reserve(table.getStates().size());
-    for(const auto & state : table.getStates())
-        m_stateGenerators.emplace_back(*state, grammar, options);
+    if(!m_options.parserStruct.empty())
+        m_driverGenerator = std::make_unique<DriverGenerator>(options);
+
+    if(m_options.useCompressedTables)
+    {
+        m_tableGenerator = std::make_unique<TableGenerator>(parser.getTable(), parser.getStates().size(), grammar, options);
+        return;
+    }
+
+    m_stateGenerators.reserve(parser.getStates().size());
+    for(const auto & state : parser.getStates())
+        m_stateGenerators.emplace_back(*state, parser.getTable(), grammar, m_profileGenerator, options);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void ParserGenerator::printTo(std::ostream & os) const
 {
+    if(m_driverGenerator)
+    {
+        m_driverGenerator->printTo(os);
+        os << std::endl;
+    }
+
+    // Branches are part of the table driven parse function
+    if(m_tableGenerator)
+    {
+        m_tableGenerator->printTo(os);
+        return;
+    }
+
+    if(m_profileGenerator.isInstrumented())
+    {
+        m_profileGenerator.printInstrumentationTo(os);
+        os << std::endl;
+    }
+    if(m_profileGenerator.hasProfile())
+    {
+        m_profileGenerator.printHintsTo(os);
+        os << std::endl;
+    }
+
     printBranchesCodeTo(os);
     os << std::endl;
     printParseCodeTo(os);
@@ -41,23 +81,44 @@ void ParserGenerator::printParseCodeTo(std::ostream & os) const
 {
     m_parseFunction.printBeginTo(os);
 
-    // Switch on state
-    m_switchOnStates.printBeginTo(os);
-    for(const auto & generator : m_stateGenerators)
-        generator.printActionsTo(os);
-    m_switchOnStates.printEndTo(os);
+    if(m_options.useComputedGotos)
+        printStatesLabelsTo(os);
+    else
+    {
+        if(m_profileGenerator.isInstrumented())
+            m_profileGenerator.printRegistrationTo(os);
+        m_switchOnStates.printBeginTo(os);
+    }
+
+    printSharedCodeTo(&StateGenerator::printLabelTo, &StateGenerator::printActionsTo, os);
+
+    if(!m_options.useComputedGotos)
+        m_switchOnStates.printEndTo(os);
 
     m_parseFunction.printEndTo(os);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void ParserGenerator::printStatesLabelsTo(std::ostream & os) const
+{
+    // Each state is a label, jumped to directly on shifts and through this table after reduces
+    os << m_options.indent << "static void * const states[] = {";
+    for(size_t numState = 0; numState < m_stateGenerators.size(); numState++)
+        os << (numState == 0 ? " " : ", ") << "&&state_" << numState;
+    os << " };" << std::endl;
+    os << m_options.indent << m_options.stateType << " state = " << m_options.topState << ';' << std::endl << std::endl;
+    if(m_profileGenerator.isInstrumented())
+        m_profileGenerator.printRegistrationTo(os);
+    os << m_options.indent << "goto *states[state];" << std::endl;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ParserGenerator::printBranchSwitchTo(std::ostream & os) const
 {
     m_branchFunction.printBeginTo(os);
 
     m_switchOnStates.printBeginTo(os);
-    for(const auto & generator : m_stateGenerators)
-        generator.printBranchesSwitchTo(os);
+    printSharedCodeTo(&StateGenerator::printCaseLabelTo, &StateGenerator::printBranchesSwitchTo, os);
     m_switchOnStates.printEndTo(os);
 
     m_branchFunction.printEndTo(os);
@@ -66,7 +127,7 @@ void ParserGenerator::printBranchSwitchTo(std::ostream & os) const
 ////////////////////////////////////////////////////////////////////////////////
 void ParserGenerator::printBranchTableTo(std::ostream & os) const
 {
-    os << m_options.indent << "const " << m_options.stateType << " " << m_options.branchFunctionName << "[] = {" << std::endl;
+    os << m_options.indent << "const " << m_options.stateType << " " << DriverGenerator::definitionName(m_options, m_options.branchFunctionName) << "[] = {" << std::endl;
     m_options.indent++;
     bool firstGenerator = true;
     for(const auto & generator : m_stateGenerators)
@@ -81,3 +142,54 @@ void ParserGenerator::printBranchTableTo(std::ostream & os) const
     m_options.indent--;
     os << m_options.indent << "};" << std::endl;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ParserGenerator::printSharedCodeTo(StatePrinter printLabel, StatePrinter printCode, std::ostream & os) const
+{
+    // Codes are rendered on several threads, each state having its own indentation
+    std::vector<std::string> statesCode(m_stateGenerators.size());
+    parallel_for(nb_workers(m_options.nbJobs), m_stateGenerators.size(), [&](size_t, size_t numState)
+    {
+        std::ostringstream code;
+        (m_stateGenerators[numState].*printCode)(code);
+        statesCode[numState] = code.str();
+    });
+
+    // States with the same actions (common with LR1 lookaheads splitting) share their code
+    std::unordered_map<std::string, size_t> codesIndex;
+    std::vector<const std::string *> codes;
+    std::vector<std::vector<const StateGenerator *>> statesOfCode;
+    for(size_t numState = 0; numState < m_stateGenerators.size(); numState++)
+    {
+        if(statesCode[numState].empty())
+            continue;
+
+        auto inserted = codesIndex.emplace(std::move(statesCode[numState]), codes.size());
+        if(inserted.second)
+        {
+            codes.push_back(&inserted.first->first);
+            statesOfCode.emplace_back();
+        }
+        statesOfCode[inserted.first->second].push_back(&m_stateGenerators[numState]);
+    }
+
+    // Hot states are laid out first, never hit ones being left out of line at the end
+    std::vector<size_t> codesOrder(codes.size());
+    std::vector<unsigned long> codesHits(codes.size());
+    for(size_t numCode = 0; numCode < codes.size(); numCode++)
+    {
+        codesOrder[numCode] = numCode;
+        for(const StateGenerator * generator : statesOfCode[numCode])
+            codesHits[numCode] += m_profileGenerator.getHits(generator->getNumState());
+    }
+    if(m_profileGenerator.hasProfile())
+        std::stable_sort(codesOrder.begin(), codesOrder.end(), [&codesHits](size_t lhs, size_t rhs) { return codesHits[lhs] > codesHits[rhs]; });
+
+    for(size_t numCode : codesOrder)
+    {
+        for(const StateGenerator * generator : statesOfCode[numCode])
+            (generator->*printLabel)(os);
+
+        os << *codes[numCode];
+    }
+}
@@ -12,14 +12,18 @@
 #include "generator/StateGenerator.h"
 #include "generator/SwitchGenerator.h"
 #include "generator/FunctionGenerator.h"
+#include "generator/TableGenerator.h"
+#include "generator/DriverGenerator.h"
+#include "generator/ProfileGenerator.h"
 
 #include <vector>
+#include <memory>
 #include <ostream>
 
 class ParserGenerator
 {
     public :
-        ParserGenerator(const Parser & table, const Grammar & grammar, Options & options);
+        ParserGenerator(const Parser & parser, const Grammar & grammar, Options & options);
 
         void printTo(std::ostream & os) const;
 
@@ -27,16 +31,24 @@ class ParserGenerator
 
         void printBranchesCodeTo(std::ostream & os) const;
         void printParseCodeTo   (std::ostream & os) const;
+        void printStatesLabelsTo(std::ostream & os) const;
         void printBranchSwitchTo(std::ostream & os) const;
         void printBranchTableTo (std::ostream & os) const;
 
-    private :
-        std::vector<StateGenerator> m_stateGenerators;
-        Options &                   m_options;
+        // Print each distinct code of states once, preceded by the labels of all states sharing it (hot ones first, when profiled)
+        using StatePrinter = void (StateGenerator::*)(std::ostream & os) const;
+        void printSharedCodeTo(StatePrinter printLabel, StatePrinter printCode, std::ostream & os) const;
 
-        FunctionGenerator           m_parseFunction;
-        FunctionGenerator           m_branchFunction;
-        SwitchGenerator             m_switchOnStates;
+    private :
+        std::vector<StateGenerator>     m_stateGenerators;
+        std::unique_ptr<TableGenerator> m_tableGenerator;
+        std::unique_ptr<DriverGenerator> m_driverGenerator;
+        Options &                       m_options;
+
+        FunctionGenerator               m_parseFunction;
+        FunctionGenerator               m_branchFunction;
+        SwitchGenerator                 m_switchOnStates;
+        ProfileGenerator                m_profileGenerator;
 };
 
 #endif /* PARSER_GENERATOR_H */
@@ -0,0 +1,270 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#include "generator/ProfileGenerator.h"
+#include "generator/SwitchGenerator.h"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <cstdint>
+
+const std::string ProfileGenerator::ANY_TERMINAL("*");
+
+////////////////////////////////////////////////////////////////////////////////
+ProfileGenerator::ProfileGenerator(const Grammar & grammar, const ParseTable & table, size_t nbStates, Options & options)
+: m_grammar(grammar), m_nbStates(nbStates), m_options(options), m_signature(getSignature(table))
+{
+    if(hasProfile())
+        load(m_options.profileFile);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ProfileGenerator::isInstrumented(void) const
+{
+    return !m_options.instrumentFile.empty();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ProfileGenerator::hasProfile(void) const
+{
+    return !m_options.profileFile.empty();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProfileGenerator::printInstrumentationTo(std::ostream & os) const
+{
+    const size_t nbTerminals = m_grammar.terminalsById.size() + 1;
+
+    std::string fileName;
+    for(char c : m_options.instrumentFile)
+    {
+        if((c == '"') || (c == '\\'))
+            fileName += '\\';
+        fileName += c;
+    }
+
+    // Hits counters, indexed by state & terminal id
+    os << m_options.indent << "static unsigned long bnf2c_profile_hits[" << m_nbStates << "][" << nbTerminals << "];" << std::endl;
+    os << m_options.indent << "static int bnf2c_profile_registered = 0;" << std::endl;
+    os << m_options.indent << "static const char * const bnf2c_profile_terminals[] = {";
+    for(const Symbol & terminal : m_grammar.terminalsById)
+        os << " \"" << terminal.name << "\",";
+    os << " \"" << ANY_TERMINAL << "\" };" << std::endl << std::endl;
+
+    // Hits are appended, profiles of several runs adding up
+    os << m_options.indent << "static void bnf2c_profile_dump(void)" << std::endl;
+    os << m_options.indent << '{' << std::endl;
+    m_options.indent++;
+    os << m_options.indent << "FILE * file = fopen(\"" << fileName << "\", \"a\");" << std::endl;
+    os << m_options.indent << "unsigned int numState, numTerminal;" << std::endl << std::endl;
+    os << m_options.indent << "if(!file)" << std::endl;
+    os << m_options.indent << m_options.indent.string << "return;" << std::endl;
+    os << m_options.indent << "fputs(\"" << getHeader() << "\\n\", file);" << std::endl;
+    os << m_options.indent << "for(numState = 0; numState < " << m_nbStates << "; numState++)" << std::endl;
+    os << m_options.indent << m_options.indent.string << "for(numTerminal = 0; numTerminal < " << nbTerminals << "; numTerminal++)" << std::endl;
+    os << m_options.indent << m_options.indent.string << m_options.indent.string << "if(bnf2c_profile_hits[numState][numTerminal] != 0)" << std::endl;
+    os << m_options.indent << m_options.indent.string << m_options.indent.string << m_options.indent.string
+       << "fprintf(file, \"%u %s %lu\\n\", numState, bnf2c_profile_terminals[numTerminal], bnf2c_profile_hits[numState][numTerminal]);" << std::endl;
+    os << m_options.indent << "fclose(file);" << std::endl;
+    m_options.indent--;
+    os << m_options.indent << '}' << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProfileGenerator::printRegistrationTo(std::ostream & os) const
+{
+    os << m_options.indent << "if(!bnf2c_profile_registered)" << std::endl;
+    os << m_options.indent << m_options.indent.string << "bnf2c_profile_registered = (atexit(bnf2c_profile_dump) == 0);" << std::endl << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProfileGenerator::printHintsTo(std::ostream & os) const
+{
+    // Branch hints are C++20 attributes, user defined otherwise
+    os << "#ifndef BNF2C_LIKELY" << std::endl;
+    os << "#if defined(__cplusplus) && (__cplusplus >= 202002L)" << std::endl;
+    os << "#define BNF2C_LIKELY   [[likely]]" << std::endl;
+    os << "#define BNF2C_UNLIKELY [[unlikely]]" << std::endl;
+    os << "#else" << std::endl;
+    os << "#define BNF2C_LIKELY" << std::endl;
+    os << "#define BNF2C_UNLIKELY" << std::endl;
+    os << "#endif" << std::endl;
+    os << "#endif" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProfileGenerator::printHitTo(int numState, const std::vector<std::string> & terminals, Indenter & indent, std::ostream & os) const
+{
+    const std::string hits = "bnf2c_profile_hits[" + std::to_string(numState) + "]";
+    if(terminals.empty())
+    {
+        os << indent << hits << '[' << getTerminalIndex(ANY_TERMINAL) << "]++;" << std::endl;
+        return;
+    }
+
+    SwitchGenerator switchOnTerminal(indent, m_options.getTypeOfToken.replaceParam(Vars::TOKEN, m_options.tokenName).toString(), "");
+    switchOnTerminal.printBeginTo(os);
+    for(const auto & terminal : terminals)
+        os << indent << "case " << m_options.tokenPrefix << terminal << " : " << hits << '[' << getTerminalIndex(terminal) << "]++; break;" << std::endl;
+    os << indent << "default : " << hits << '[' << getTerminalIndex(ANY_TERMINAL) << "]++; break;" << std::endl;
+    switchOnTerminal.printEndTo(os, false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unsigned long ProfileGenerator::getHits(int numState) const
+{
+    auto it = m_stateHits.find(numState);
+    return (it != m_stateHits.end()) ? it->second : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unsigned long ProfileGenerator::getHits(int numState, const std::string & terminal) const
+{
+    auto itState = m_hits.find(numState);
+    if(itState == m_hits.end())
+        return 0;
+
+    auto it = itState->second.find(terminal);
+    return (it != itState->second.end()) ? it->second : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ProfileGenerator::getHint(unsigned long hits, unsigned long stateHits)
+{
+    // Never taken while profiling a state that was
+    if(stateHits == 0)
+        return "";
+    if(hits == 0)
+        return "BNF2C_UNLIKELY";
+    if(hits > stateHits / 2)
+        return "BNF2C_LIKELY";
+
+    return "";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProfileGenerator::load(const std::string & fileName)
+{
+    std::ifstream file(fileName);
+    if(file.fail())
+        throw std::runtime_error("Unable to open profile file \"" + fileName + "\"");
+
+    // Lines of several runs may be repeated, their hits add up
+    std::string line;
+    bool hasHeader = false;
+    for(int numLine = 1; std::getline(file, line); numLine++)
+    {
+        // Each run starts with the header of the parser profiled
+        if(line.compare(0, 1, "#") == 0)
+        {
+            checkHeader(line, fileName);
+            hasHeader = true;
+            continue;
+        }
+
+        std::istringstream iss(line);
+        int numState;
+        std::string terminal;
+        unsigned long hits;
+        if(!(iss >> numState >> terminal >> hits))
+        {
+            if(line.find_first_not_of(" \t\r") == std::string::npos)
+                continue;
+
+            throw std::runtime_error("Malformed line " + std::to_string(numLine) + " of profile file \"" + fileName + "\"");
+        }
+
+        if(!hasHeader)
+            throw std::runtime_error("Profile file \"" + fileName + "\" has no header, the parser has to be profiled again");
+
+        // Hits of unknown states or terminals are ignored
+        if((numState < 0) || (static_cast<size_t>(numState) >= m_nbStates) || !isKnownTerminal(terminal))
+            continue;
+
+        m_hits[numState][terminal] += hits;
+        m_stateHits[numState]      += hits;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ProfileGenerator::checkHeader(const std::string & line, const std::string & fileName) const
+{
+    std::istringstream iss(line);
+    std::string hash, tool, kind;
+    size_t nbStates, nbTerminals;
+    std::string signature;
+    if(!(iss >> hash >> tool >> kind >> nbStates >> nbTerminals >> signature) || (tool != "bnf2c") || (kind != "profile"))
+        throw std::runtime_error("Malformed header \"" + line + "\" in profile file \"" + fileName + "\"");
+
+    // States are numbered differently as soon as the parse table changes
+    if(line != getHeader())
+    {
+        throw std::runtime_error("Profile file \"" + fileName + "\" doesn't match the parser (\""
+            + line.substr(2) + "\" instead of \"" + getHeader().substr(2) + "\"), the parser has to be profiled again");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ProfileGenerator::getHeader(void) const
+{
+    return "# bnf2c profile " + std::to_string(m_nbStates) + ' ' + std::to_string(m_grammar.terminalsById.size()) + ' ' + m_signature;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string ProfileGenerator::getSignature(const ParseTable & table) const
+{
+    // FNV-1a hash of terminals names, actions & gotos of all states (the same on any platform)
+    std::uint64_t hash = 14695981039346656037ULL;
+    auto addByte = [&hash](std::uint8_t byte)
+    {
+        hash ^= byte;
+        hash *= 1099511628211ULL;
+    };
+    auto addInt = [&addByte](std::int64_t value)
+    {
+        for(int i = 0; i < 8; i++)
+            addByte(static_cast<std::uint64_t>(value) >> (8 * i));
+    };
+
+    for(const Symbol & terminal : m_grammar.terminalsById)
+    {
+        for(char c : terminal.name)
+            addByte(c);
+        addByte(0);
+    }
+
+    for(size_t numState = 0; numState < m_nbStates; numState++)
+    {
+        for(const Symbol & terminal : m_grammar.terminalsById)
+            addInt(table.getAction(numState, terminal).getCode());
+        addInt(table.getDefaultAction(numState).getCode());
+        for(const Symbol & intermediate : m_grammar.intermediatesById)
+            addInt(table.getGoto(numState, intermediate));
+    }
+
+    std::ostringstream oss;
+    oss << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return oss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ProfileGenerator::isKnownTerminal(const std::string & terminal) const
+{
+    return (terminal == ANY_TERMINAL) || (terminal == m_grammar.endOfInput.name) || (m_grammar.terminals.count(terminal) != 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+size_t ProfileGenerator::getTerminalIndex(const std::string & terminal) const
+{
+    if(terminal == ANY_TERMINAL)
+        return m_grammar.terminalsById.size();
+    if(terminal == m_grammar.endOfInput.name)
+        return m_grammar.endOfInput.id;
+
+    return m_grammar.terminals.at(terminal).id;
+}
@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef PROFILE_GENERATOR_H
+#define PROFILE_GENERATOR_H
+#include "core/Grammar.h"
+#include "core/ParseTable.h"
+#include "config/Options.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <ostream>
+
+// Profile guided generation : an instrumented parser counts the terminals each
+// state is entered with, and appends those hits to a profile file at exit
+// (one "<state> <terminal> <hits>" line each, "*" standing for any other terminal),
+// after a "# bnf2c profile <states> <terminals> <signature>" header line.
+// Given back to bnf2c, hot states & terminals are generated first, with their
+// cases hinted as likely (cold ones as unlikely). The signature of the parse table
+// tells whether states are still numbered the same, a stale profile being rejected.
+class ProfileGenerator
+{
+    public :
+        static const std::string ANY_TERMINAL;
+
+    public :
+        ProfileGenerator(const Grammar & grammar, const ParseTable & table, size_t nbStates, Options & options);
+
+        bool isInstrumented(void) const;
+        bool hasProfile(void) const;
+
+        void printInstrumentationTo(std::ostream & os) const;
+        void printRegistrationTo   (std::ostream & os) const;
+        void printHintsTo          (std::ostream & os) const;
+
+        // Count a hit of the current terminal, among the ones explicitly handled by the state
+        void printHitTo(int numState, const std::vector<std::string> & terminals, Indenter & indent, std::ostream & os) const;
+
+        unsigned long getHits(int numState) const;
+        unsigned long getHits(int numState, const std::string & terminal) const;
+
+        // Hint of a case taken "hits" times out of "stateHits"
+        static std::string getHint(unsigned long hits, unsigned long stateHits);
+
+    private :
+        void load(const std::string & fileName);
+        void checkHeader(const std::string & line, const std::string & fileName) const;
+
+        std::string getHeader(void) const;
+        std::string getSignature(const ParseTable & table) const;
+        bool        isKnownTerminal(const std::string & terminal) const;
+        size_t      getTerminalIndex(const std::string & terminal) const;
+
+    private :
+        const Grammar & m_grammar;
+        size_t          m_nbStates;
+        Options &       m_options;
+        std::string     m_signature;
+
+        std::unordered_map<int, std::unordered_map<std::string, unsigned long>> m_hits;
+        std::unordered_map<int, unsigned long>                                  m_stateHits;
+};
+
+#endif /* PROFILE_GENERATOR_H */
@@ -7,136 +7,205 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "generator/StateGenerator.h"
 #include <map>
-#include <set>
+#include <unordered_map>
 #include <sstream>
+#include <algorithm>
 
 ////////////////////////////////////////////////////////////////////////////////
-StateGenerator::StateGenerator(const ParserState & state, const Grammar & grammar, Options & options)
-: m_state(state), m_grammar(grammar), m_options(options),
-    m_switchOnIntermediate(m_options.indent, m_options.intermediateName, m_options.defaultSwitchStatement ? "return " + m_options.errorState + ";" : ""), 
-    m_switchOnTerminal(m_options.indent, m_options.getTypeOfToken.replaceParam(Vars::TOKEN, m_options.tokenName).toString(), m_options.defaultSwitchStatement ? "return " + m_options.errorState + ";" : "")
+StateGenerator::StateGenerator(const ParserState & state, const ParseTable & table, const Grammar & grammar, const ProfileGenerator & profile, Options & options)
+: m_state(state), m_table(table), m_grammar(grammar), m_profile(profile), m_options(options), m_indent(options.indent)
 {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void StateGenerator::printActionsTo(std::ostream & os) const
+void StateGenerator::printLabelTo(std::ostream & os) const
 {
-    os << m_options.indent << "case " << m_state.numState << " :" << std::endl;
+    m_indent = m_options.indent;
+    if(m_options.useComputedGotos)
+        os << m_indent << "state_" << m_state.numState << " :" << std::endl;
+    else
+        printCaseLabelTo(os);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StateGenerator::printCaseLabelTo(std::ostream & os) const
+{
+    m_indent = m_options.indent;
+    os << m_indent << "case " << m_state.numState << " :" << std::endl;
+}
 
-    m_options.indent++;
+////////////////////////////////////////////////////////////////////////////////
+void StateGenerator::printActionsTo(std::ostream & os) const
+{
+    // Own indentation, states being printed in parallel
+    m_indent = m_options.indent;
+    m_indent++;
     printActionItemsTo(os);
-    m_options.indent--;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void StateGenerator::printBranchesSwitchTo(std::ostream & os) const
 {
-    std::unordered_set<std::string> outCases;
-    m_options.indent++++;
-    for(const Item & item : m_state.items)
+    const SwitchGenerator switchOnIntermediate(m_indent, m_options.intermediateName, getSwitchDefaultCode());
+    std::vector<std::string> outCases;
+    m_indent = m_options.indent;
+    m_indent++++;
+    for(const auto & intermediate : m_grammar.intermediatesById)
     {
-        std::stringstream os;
-
-        if(!item.isDotAtEnd() && item.dottedSymbol->isIntermediate())
+        const int nextState = m_table.getGoto(m_state.numState, intermediate);
+        if(nextState != ParseTable::NO_STATE)
         {
-            os << m_options.indent << "case " << m_grammar.getIntermediateIndex(item.dottedSymbol->name) << " : ";
-            if(item.nextState != nullptr)
-                os << "return " << item.nextState->numState << ";" << std::endl;
-            else
-                os << "return " << m_options.errorState << ";" << std::endl;
-            outCases.insert(os.str());
+            std::stringstream os;
+            os << m_indent << "case " << intermediate.id << " : return " << nextState << ";" << std::endl;
+            outCases.push_back(os.str());
         }
     }
-    m_options.indent----;
+    m_indent----;
 
+    // Switch on intermediate, the state label being left to the caller
     if(!outCases.empty())
     {
-        // Epilog
-        os << m_options.indent << "case " << m_state.numState << " :";
-        m_options.indent++;
-
-        os << std::endl;
-        m_switchOnIntermediate.printBeginTo(os);
+        m_indent++;
+        switchOnIntermediate.printBeginTo(os);
         for(const std::string & str : outCases)
             os << str;
-        m_switchOnIntermediate.printEndTo(os);
+        switchOnIntermediate.printEndTo(os);
 
-        os << m_options.indent << "break;" << std::endl;
-        m_options.indent--;
+        os << m_indent << "break;" << std::endl;
+        m_indent--;
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void StateGenerator::printBranchesTableTo(std::ostream & os) const
 {
-    os << m_options.indent;
-    for(const auto & intermediate : m_grammar.intermediates)
+    m_indent = m_options.indent;
+    os << m_indent;
+    for(const auto & intermediate : m_grammar.intermediatesById)
     {
-        if(intermediate != *m_grammar.intermediates.begin())
+        if(intermediate.id != 0)
             os << ", ";
 
-        ParserState::ItemList::const_iterator itItem;
-        for(itItem = m_state.items.begin(); itItem != m_state.items.end(); ++itItem)
-            if(!itItem->isDotAtEnd() && itItem->dottedSymbol->name == intermediate)
-                break;
-
-        if(itItem != m_state.items.end() && (itItem->nextState != nullptr))
-            os << itItem->nextState->numState;
+        const int nextState = m_table.getGoto(m_state.numState, intermediate);
+        if(nextState != ParseTable::NO_STATE)
+            os << nextState;
         else
             os << m_options.errorState;
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int StateGenerator::getNumState(void) const
+{
+    return m_state.numState;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void StateGenerator::printActionItemsTo(std::ostream & os) const
 {
-    // If whatever the terminal the action is the same, don't generate a switch
-    if(m_state.isSameActionForAllTerminals(m_grammar, m_options.endOfInputToken))
+    // Consistent states reduce whatever the terminal, don't generate a switch
+    const auto defaultAction = m_table.getDefaultAction(m_state.numState);
+    if(m_table.isConsistent(m_state.numState))
     {
-        printReduceActionTo(m_state.items.front().rule, os);
+        if(m_profile.isInstrumented())
+            m_profile.printHitTo(m_state.numState, {}, m_indent, os);
+
+        printReduceActionTo(m_table.getRule(defaultAction.getNumRule()), os);
     }
     else
     {
-        // Regroup all cases of an item
-        std::unordered_map<ParsingAction, std::unordered_set<std::string> > cases;
-        for(const auto & terminal : m_grammar.terminals)
-            cases[m_state.getAction(terminal, m_options.endOfInputToken)].insert(terminal);
-        cases[m_state.getAction(m_options.endOfInputToken, m_options.endOfInputToken)].insert(m_options.endOfInputToken);
+        // Regroup all cases of an item, the default one being left to the default case.
+        // Cases & their terminals are kept in order of terminal ids, for a reproducible output
+        std::vector<std::pair<ParsingAction, std::vector<std::string>>> orderedCases;
+        std::unordered_map<ParsingAction, size_t> casesIndex;
+        for(const auto & terminal : m_grammar.terminalsById)
+        {
+            const ParsingAction action = m_table.getAction(m_state.numState, terminal);
+            if(action == defaultAction)
+                continue;
+
+            auto inserted = casesIndex.emplace(action, orderedCases.size());
+            if(inserted.second)
+                orderedCases.emplace_back(action, std::vector<std::string>());
+            orderedCases[inserted.first->second].second.push_back(terminal.name);
+        }
+
+        // Hot cases first, when profiled
+        if(m_profile.hasProfile())
+        {
+            std::stable_sort(orderedCases.begin(), orderedCases.end(), [this](const auto & lhs, const auto & rhs) {
+                return getHits(lhs.second) > getHits(rhs.second);
+            });
+        }
+
+        // Count terminals handled by a case, others being counted as the default one
+        if(m_profile.isInstrumented())
+        {
+            std::vector<std::string> terminals;
+            for(const auto & casesOfItem : orderedCases)
+                if(casesOfItem.first.getType() != ParsingAction::Type::ERROR)
+                    terminals.insert(terminals.end(), casesOfItem.second.begin(), casesOfItem.second.end());
+
+            m_profile.printHitTo(m_state.numState, terminals, m_indent, os);
+        }
 
         // Switch on terminal
-        m_switchOnTerminal.printBeginTo(os);
-        for(const auto & casesOfItem : cases)
+        const SwitchGenerator switchOnTerminal(m_indent, m_options.getTypeOfToken.replaceParam(Vars::TOKEN, m_options.tokenName).toString(), getSwitchDefaultCode());
+        switchOnTerminal.printBeginTo(os);
+        for(const auto & casesOfItem : orderedCases)
         {
+            // Each terminal may lead to its own chain of reduces
+            if(m_options.fuseReduces && casesOfItem.first.getType() == ParsingAction::Type::REDUCE)
+            {
+                printFusedReducesTo(m_table.getRule(casesOfItem.first.getNumRule()), casesOfItem.second, os);
+                continue;
+            }
+
             // Generate all cases
-            if(casesOfItem.first.type != ParsingAction::Type::ERROR)
+            if(casesOfItem.first.getType() != ParsingAction::Type::ERROR)
             {
                 for(const auto & terminal : casesOfItem.second)
                 {
-                    os << m_options.indent << "case " << m_options.tokenPrefix << terminal << " : ";
+                    os << m_indent << "case " << m_options.tokenPrefix << terminal << " : ";
 
                     if(casesOfItem.second.size() > 1)
                         os << std::endl;
                 }
             }
 
-            // Generate action
-            switch(casesOfItem.first.type)
+            // Generate action, preceded by its branch hint
+            const std::string hint = getHint(casesOfItem.second);
+            switch(casesOfItem.first.getType())
             {
                 case ParsingAction::Type::SHIFT :
                     if(casesOfItem.second.size() == 1)
-                        printShiftActionTo(casesOfItem.first.shiftNextState, os);
+                    {
+                        if(!hint.empty())
+                            os << hint << ' ';
+                        printShiftActionTo(casesOfItem.first.getNextState(), os);
+                    }
                     else
                     {
-                        m_options.indent++;
-                        os << m_options.indent;
-                        printShiftActionTo(casesOfItem.first.shiftNextState, os);
-                        m_options.indent--;
+                        m_indent++;
+                        os << m_indent;
+                        if(!hint.empty())
+                            os << hint << ' ';
+                        printShiftActionTo(casesOfItem.first.getNextState(), os);
+                        m_indent--;
                     }
                     break;
                 case ParsingAction::Type::REDUCE :
-                    printReduceActionTo(*casesOfItem.first.reduceRule, os);
+                    if(!hint.empty())
+                    {
+                        if(casesOfItem.second.size() > 1)
+                            os << m_indent;
+                        os << hint << std::endl;
+                    }
+                    printReduceActionTo(m_table.getRule(casesOfItem.first.getNumRule()), os);
                     break;
                 case ParsingAction::Type::ACCEPT :
+                    if(!hint.empty())
+                        os << hint << ' ';
                     os << "return " << m_options.acceptState << ";" << std::endl;
                     break;
                 case ParsingAction::Type::ERROR :
@@ -144,54 +213,220 @@ void StateGenerator::printActionItemsTo(std::ostream & os) const
                     break;
             }
         }
+
+        // Default reduce, also taken on errors
+        if(defaultAction.getType() == ParsingAction::Type::REDUCE)
+        {
+            const std::string hint = getHint({ ProfileGenerator::ANY_TERMINAL });
+            os << m_indent << "default : ";
+            if(!hint.empty())
+                os << hint << std::endl;
+            printReduceActionTo(m_table.getRule(defaultAction.getNumRule()), os);
+            switchOnTerminal.printEndTo(os, false);
+        }
+        else
+            switchOnTerminal.printEndTo(os);
     }
 
-    m_switchOnTerminal.printEndTo(os);
-    os << m_options.indent << "break;" << std::endl;
+    // There is no switch on states to break out of with computed gotos
+    if(m_options.useComputedGotos)
+        os << m_indent << "return " << m_options.errorState << ";" << std::endl;
+    else
+        os << m_indent << "break;" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StateGenerator::printFusedReducesTo(const Rule & reduceRule, const std::vector<std::string> & terminals, std::ostream & os) const
+{
+    // Regroup terminals by chain, a chain being identified by its rules & next state
+    std::map<std::vector<int>, std::pair<ReduceChain, std::vector<std::string>>> chains;
+    for(const auto & terminal : terminals)
+    {
+        const Symbol & symbol = (terminal == m_grammar.endOfInput.name) ? m_grammar.endOfInput : m_grammar.terminals.at(terminal);
+        ReduceChain chain = getReduceChain(reduceRule, &symbol);
+
+        std::vector<int> key;
+        for(const Rule * rule : chain.rules)
+            key.push_back(rule->numRule);
+        key.push_back(chain.nextState);
+
+        auto & terminalsOfChain = chains[key];
+        terminalsOfChain.first = std::move(chain);
+        terminalsOfChain.second.push_back(terminal);
+    }
+
+    for(const auto & chain : chains)
+    {
+        for(const auto & terminal : chain.second.second)
+        {
+            os << m_indent << "case " << m_options.tokenPrefix << terminal << " : ";
+
+            if(chain.second.second.size() > 1)
+                os << std::endl;
+        }
+
+        const std::string hint = getHint(chain.second.second);
+        if(!hint.empty())
+        {
+            if(chain.second.second.size() > 1)
+                os << m_indent;
+            os << hint << std::endl;
+        }
+        printReduceChainTo(chain.second.first, os);
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void StateGenerator::printReduceActionTo(const Rule & reduceRule, std::ostream & os) const
 {
-    os << m_options.indent << '{' << std::endl;
-    m_options.indent++;
+    // Whatever the terminal
+    printReduceChainTo(getReduceChain(reduceRule, nullptr), os);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void StateGenerator::printReduceChainTo(const ReduceChain & chain, std::ostream & os) const
+{
+    os << m_indent << '{' << std::endl;
+    m_indent++;
+
+    // Each reduce of a chain has its own block, only the last goto state being pushed
+    const bool isFused = chain.rules.size() > 1;
+    for(const Rule * reduceRule : chain.rules)
+    {
+        // Popping a value to push it back as is does nothing
+        if(isFused && reduceRule->isUnitCopy)
+            continue;
+
+        if(isFused)
+        {
+            os << m_indent << '{' << std::endl;
+            m_indent++;
+        }
 
-    // Rule action code
-    os << m_options.indent << m_options.valueType << ' ' << Vars::RETURN << ';' << std::endl << std::endl;
+        // Rule action code
+        os << m_indent << m_options.valueType << ' ' << Vars::RETURN << ';' << std::endl << std::endl;
 
-    if(reduceRule.action.find_first_of("\n\r") == std::string::npos)
-        os << m_options.indent;
-    os << reduceRule.action << std::endl << std::endl;
+        if(reduceRule->action.find_first_of("\n\r") == std::string::npos)
+            os << m_indent;
+        os << reduceRule->action << std::endl << std::endl;
 
-    // Values stack
-    os << m_options.indent << m_options.popValues.replaceParam(Vars::NB_VALUES, std::to_string(reduceRule.symbols.size()))  << std::endl;
-    os << m_options.indent << m_options.pushValue.replaceParam(Vars::VALUE,     Vars::RETURN)                       << std::endl;
+        // Values stack
+        os << m_indent << m_options.popValues.replaceParam(Vars::NB_VALUES, std::to_string(reduceRule->symbols.size()))  << std::endl;
+        os << m_indent << m_options.pushValue.replaceParam(Vars::VALUE,     Vars::RETURN)                       << std::endl;
+
+        if(isFused)
+        {
+            m_indent--;
+            os << m_indent << '}' << std::endl;
+        }
+    }
 
     // States stack
-    os << m_options.indent << m_options.popState.replaceParam(Vars::NB_STATES, std::to_string(reduceRule.symbols.size())) << std::endl;
+    os << m_indent << m_options.popState.replaceParam(Vars::NB_STATES, std::to_string(chain.nbStates)) << std::endl;
 
-    // New state
-    if(m_options.useTableForBranches)
-        os << m_options.indent << "return " << m_options.branchFunctionName << "[(" << m_grammar.intermediates.size() << "*" << m_options.topState << ") + " << m_grammar.getIntermediateIndex(reduceRule.name) << "];" << std::endl;
+    // New state, statically known or found by branch
+    const Rule & reduceRule = *chain.rules.back();
+    const std::string newState = m_options.useComputedGotos ? "state = " : "return ";
+    if(chain.nextState != ParseTable::NO_STATE)
+    {
+        if(m_options.useComputedGotos)
+            os << m_indent << m_options.pushState.replaceParam(Vars::STATE, std::to_string(chain.nextState)) << " goto state_" << chain.nextState << ';' << std::endl;
+        else
+            os << m_indent << "return " << chain.nextState << ';' << std::endl;
+    }
     else
-        os << m_options.indent << "return " << m_options.branchFunctionName << "(" << m_grammar.getIntermediateIndex(reduceRule.name) << ");" << std::endl;
+    {
+        if(m_options.useTableForBranches)
+            os << m_indent << newState << m_options.branchFunctionName << "[(" << m_grammar.intermediates.size() << "*" << m_options.topState << ") + " << reduceRule.intermediate.id << "];" << std::endl;
+        else
+            os << m_indent << newState << m_options.branchFunctionName << "(" << reduceRule.intermediate.id << ");" << std::endl;
+
+        if(m_options.useComputedGotos)
+        {
+            os << m_indent << m_options.pushState.replaceParam(Vars::STATE, "state") << std::endl;
+            os << m_indent << "goto *states[state];" << std::endl;
+        }
+    }
 
-    m_options.indent--;
-    os << m_options.indent << '}' << std::endl;
+    m_indent--;
+    os << m_indent << '}' << std::endl;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void StateGenerator::printShiftActionTo(const ParserState * nextState, std::ostream & os) const
+void StateGenerator::printShiftActionTo(int nextState, std::ostream & os) const
 {
     // Push token
-    os << m_options.pushValue.replaceParam(Vars::VALUE, m_options.tokenName);
+    os << m_options.pushToken.replaceParam(Vars::VALUE, m_options.tokenName);
 
     // Shift
     os << ' ' << m_options.shiftToken;
-
-    if(nextState != nullptr)
-        os << " return " << nextState->numState << ';' << std::endl;
+    if(m_options.useComputedGotos)
+        os << ' ' << m_options.pushState.replaceParam(Vars::STATE, std::to_string(nextState)) << " goto state_" << nextState << ';' << std::endl;
     else
-        os << " return " << m_options.errorState << ';' << std::endl;
+        os << " return " << nextState << ';' << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+StateGenerator::ReduceChain StateGenerator::getReduceChain(const Rule & reduceRule, const Symbol * terminal) const
+{
+    ReduceChain chain;
+    chain.rules.push_back(&reduceRule);
+    chain.nbStates = reduceRule.symbols.size();
+    if(!m_options.fuseReduces)
+        return chain;
+
+    // Follow gotos known whatever the states stack, while they reduce again on the same terminal
+    // (or whatever the terminal, for consistent states). Without a terminal, only consistent states are followed.
+    int numState = m_state.numState;
+    const Rule * rule = &reduceRule;
+    for(;;)
+    {
+        chain.nextState = m_table.getReduceGoto(numState, *rule);
+        if(chain.nextState == ParseTable::NO_STATE)
+            return chain;
+
+        ParsingAction action;
+        if(terminal != nullptr)
+            action = m_table.getTakenAction(chain.nextState, *terminal);
+        else if(m_table.isConsistent(chain.nextState))
+            action = m_table.getDefaultAction(chain.nextState);
+
+        if(action.getType() != ParsingAction::Type::REDUCE || chain.rules.size() == MAX_FUSED_REDUCES)
+            return chain;
+
+        // The goto state is popped right away, unless the next rule is empty
+        const Rule & nextRule = m_table.getRule(action.getNumRule());
+        if(nextRule.symbols.empty())
+            return chain;
+
+        chain.rules.push_back(&nextRule);
+        chain.nbStates += nextRule.symbols.size() - 1;
+        numState = chain.nextState;
+        rule     = &nextRule;
+    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+unsigned long StateGenerator::getHits(const std::vector<std::string> & terminals) const
+{
+    unsigned long hits = 0;
+    for(const auto & terminal : terminals)
+        hits += m_profile.getHits(m_state.numState, terminal);
+
+    return hits;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string StateGenerator::getHint(const std::vector<std::string> & terminals) const
+{
+    if(!m_profile.hasProfile())
+        return "";
+
+    return ProfileGenerator::getHint(getHits(terminals), m_profile.getHits(m_state.numState));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::string StateGenerator::getSwitchDefaultCode(void) const
+{
+    return m_options.defaultSwitchStatement ? "return " + m_options.errorState + ";" : "";
+}
@@ -7,32 +7,59 @@
 #ifndef STATE_GENERATOR_H
 #define STATE_GENERATOR_H
 #include "core/ParserState.h"
+#include "core/ParseTable.h"
 #include "core/Grammar.h"
 #include "config/Options.h"
 #include "generator/SwitchGenerator.h"
+#include "generator/ProfileGenerator.h"
 
+#include <vector>
 #include <ostream>
 
 class StateGenerator
 {
     public :
-        StateGenerator(const ParserState & state, const Grammar & grammar, Options & options);
+        StateGenerator(const ParserState & state, const ParseTable & table, const Grammar & grammar, const ProfileGenerator & profile, Options & options);
 
+        void printLabelTo         (std::ostream & os) const;
+        void printCaseLabelTo     (std::ostream & os) const;
         void printActionsTo       (std::ostream & os) const;
         void printBranchesSwitchTo(std::ostream & os) const;
         void printBranchesTableTo (std::ostream & os) const;
 
+        int getNumState(void) const;
+
     private :
+        // Reduces taken one after the other, ending on a statically known state (or a branch)
+        struct ReduceChain
+        {
+            std::vector<const Rule *> rules;
+            size_t                    nbStates  = 0;
+            int                       nextState = ParseTable::NO_STATE;
+        };
+
+        static const size_t MAX_FUSED_REDUCES = 8;
+
         void printActionItemsTo (std::ostream & os) const;
+        void printFusedReducesTo(const Rule & reduceRule, const std::vector<std::string> & terminals, std::ostream & os) const;
         void printReduceActionTo(const Rule & reduceRule, std::ostream & os) const;
-        void printShiftActionTo (const ParserState * nextState, std::ostream & os) const;
+        void printReduceChainTo (const ReduceChain & chain, std::ostream & os) const;
+        void printShiftActionTo (int nextState, std::ostream & os) const;
+
+        ReduceChain getReduceChain(const Rule & reduceRule, const Symbol * terminal) const;
+
+        unsigned long getHits(const std::vector<std::string> & terminals) const;
+        std::string   getHint(const std::vector<std::string> & terminals) const;
+
+        std::string getSwitchDefaultCode(void) const;
 
     private :
-        const ParserState & m_state;
-        const Grammar &     m_grammar;
-        Options &           m_options;
-        SwitchGenerator     m_switchOnIntermediate;
-        SwitchGenerator     m_switchOnTerminal;
+        const ParserState &      m_state;
+        const ParseTable &       m_table;
+        const Grammar &          m_grammar;
+        const ProfileGenerator & m_profile;
+        Options &                m_options;
+        mutable Indenter         m_indent;
 };
 
 #endif /* STATES_GENERATOR_H */
@@ -21,9 +21,10 @@ void SwitchGenerator::printBeginTo(std::ostream & os) const
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void SwitchGenerator::printEndTo(std::ostream & os) const
+void SwitchGenerator::printEndTo(std::ostream & os, bool withDefault) const
 {
-    printDefaultTo(os);
+    if(withDefault)
+        printDefaultTo(os);
     m_indenter--;
     os << m_indenter << "}" << std::endl;
 }
@@ -15,7 +15,7 @@ class SwitchGenerator
         SwitchGenerator(Indenter & indenter, const std::string & switchOnExpr, const std::string & defaultCode);
 
         void printBeginTo(std::ostream & os) const;
-        void printEndTo(std::ostream & os) const;
+        void printEndTo(std::ostream & os, bool withDefault = true) const;
 
     private :
         void printDefaultTo(std::ostream & os) const;
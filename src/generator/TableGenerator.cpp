@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#include "generator/TableGenerator.h"
+#include "generator/DriverGenerator.h"
+
+#include <map>
+
+static const size_t VALUES_PER_LINE = 16;
+
+////////////////////////////////////////////////////////////////////////////////
+TableGenerator::TableGenerator(const ParseTable & table, size_t nbStates, const Grammar & grammar, Options & options)
+: m_table(table), m_grammar(grammar), m_options(options), m_actions(grammar.terminalsById.size()), m_gotos(nbStates),
+    m_parseFunction(m_options.indent, m_options.stateType, DriverGenerator::parseActionName(m_options), m_options.tokenType, m_options.tokenName, m_options.throwedExceptions, m_options.errorState),
+    m_switchOnTerminal(m_options.indent, m_options.getTypeOfToken.replaceParam(Vars::TOKEN, m_options.tokenName).toString(), "return " + m_options.errorState + ";"),
+    m_switchOnRule(m_options.indent, "-action", "return " + m_options.errorState + ";")
+{
+    // ACTION rows are states and columns terminals, errors are left to the default action
+    std::vector<bool> isReduced(grammar.rules.size() + 1, false);
+    for(size_t numState = 0; numState < nbStates; numState++)
+    {
+        const ParsingAction defaultAction = table.getDefaultAction(numState);
+        if(defaultAction.getType() == ParsingAction::Type::REDUCE)
+            isReduced[defaultAction.getNumRule()] = true;
+
+        std::vector<CompressedTable::Entry> entries;
+        for(const auto & terminal : grammar.terminalsById)
+        {
+            const ParsingAction action = table.getAction(numState, terminal);
+            if(action.getType() == ParsingAction::Type::ERROR || action == defaultAction)
+                continue;
+
+            if(action.getType() == ParsingAction::Type::REDUCE)
+                isReduced[action.getNumRule()] = true;
+
+            entries.emplace_back(terminal.id, encode(action));
+        }
+
+        m_actions.addRow(std::move(entries), encode(defaultAction));
+    }
+    m_actions.pack();
+
+    // Consistent states have no entry, a negative base tells the token isn't even needed
+    for(size_t numState = 0; numState < nbStates; numState++)
+        if(table.isConsistent(numState))
+            m_actions.base[numState] = -1;
+
+    for(size_t numRule = 0; numRule < isReduced.size(); numRule++)
+        if(isReduced[numRule])
+            m_reducedRules.push_back(numRule);
+
+    // GOTO rows are intermediates and columns states. A goto is only looked up after a reduce,
+    // so it is never empty : the most frequent next state of an intermediate is its default.
+    for(const Symbol & intermediate : grammar.intermediatesById)
+    {
+        std::map<int, size_t> nbGotos;
+        for(size_t numState = 0; numState < nbStates; numState++)
+        {
+            const int nextState = table.getGoto(numState, intermediate);
+            if(nextState != ParseTable::NO_STATE)
+                nbGotos[nextState]++;
+        }
+
+        int defaultState = 0;
+        size_t nbDefaultGotos = 0;
+        for(const auto & nbGotosOfState : nbGotos)
+        {
+            if(nbGotosOfState.second > nbDefaultGotos)
+            {
+                defaultState   = nbGotosOfState.first;
+                nbDefaultGotos = nbGotosOfState.second;
+            }
+        }
+
+        std::vector<CompressedTable::Entry> entries;
+        for(size_t numState = 0; numState < nbStates; numState++)
+        {
+            const int nextState = table.getGoto(numState, intermediate);
+            if(nextState != ParseTable::NO_STATE && nextState != defaultState)
+                entries.emplace_back(numState, nextState);
+        }
+
+        m_gotos.addRow(std::move(entries), defaultState);
+    }
+    m_gotos.pack();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TableGenerator::printTo(std::ostream & os) const
+{
+    const std::string templateDeclaration = DriverGenerator::templateDeclaration(m_options);
+    if(!templateDeclaration.empty())
+        os << m_options.indent << templateDeclaration << std::endl;
+    m_parseFunction.printBeginTo(os);
+
+    // Tables
+    printTableTo("actionBase",    m_actions.base,     os);
+    printTableTo("actionCheck",   m_actions.check,    os);
+    printTableTo("actionNext",    m_actions.next,     os);
+    printTableTo("actionDefault", m_actions.defaults, os);
+    printTableTo("gotoBase",      m_gotos.base,       os);
+    printTableTo("gotoCheck",     m_gotos.check,      os);
+    printTableTo("gotoNext",      m_gotos.next,       os);
+    printTableTo("gotoDefault",   m_gotos.defaults,   os);
+    os << m_options.indent << "int terminal;" << std::endl;
+    os << m_options.indent << "int action;" << std::endl;
+    os << m_options.indent << m_options.intermediateType << ' ' << m_options.intermediateName << ';' << std::endl;
+    os << m_options.indent << m_options.stateType << " state = " << m_options.topState << ';' << std::endl << std::endl;
+
+    // Action
+    os << m_options.indent << "if(actionBase[state] < 0)" << std::endl;
+    m_options.indent++;
+    os << m_options.indent << "action = actionDefault[state];" << std::endl;
+    m_options.indent--;
+    os << m_options.indent << "else" << std::endl;
+    os << m_options.indent << '{' << std::endl;
+    m_options.indent++;
+    printTerminalSwitchTo(os);
+    os << m_options.indent << "action = (actionCheck[actionBase[state] + terminal] == state) ? actionNext[actionBase[state] + terminal] : actionDefault[state];" << std::endl;
+    m_options.indent--;
+    os << m_options.indent << '}' << std::endl << std::endl;
+    os << m_options.indent << "if(action > 0)" << std::endl;
+    os << m_options.indent << '{' << std::endl;
+    m_options.indent++;
+    os << m_options.indent << m_options.pushToken.replaceParam(Vars::VALUE, m_options.tokenName) << ' ' << m_options.shiftToken << std::endl;
+    os << m_options.indent << "return action - 1;" << std::endl;
+    m_options.indent--;
+    os << m_options.indent << '}' << std::endl << std::endl;
+
+    // Reduce
+    m_switchOnRule.printBeginTo(os);
+    os << m_options.indent << "case 1 : return " << m_options.acceptState << ";" << std::endl;
+    for(int numRule : m_reducedRules)
+        printReduceActionTo(m_table.getRule(numRule), os);
+    m_switchOnRule.printEndTo(os);
+    os << std::endl;
+
+    // Goto
+    const std::string gotoIndex = "gotoBase[" + m_options.intermediateName + "] + state";
+    os << m_options.indent << "state = " << m_options.topState << ';' << std::endl;
+    os << m_options.indent << "return (gotoCheck[" << gotoIndex << "] == " << m_options.intermediateName << ") ? gotoNext[" << gotoIndex << "] : gotoDefault[" << m_options.intermediateName << "];" << std::endl;
+
+    m_parseFunction.printEndTo(os);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TableGenerator::printTableTo(const std::string & name, const std::vector<int> & values, std::ostream & os) const
+{
+    if(m_options.useConstexprTables)
+        os << m_options.indent << "static constexpr std::array<int, " << values.size() << "> " << name << " = {{";
+    else
+        os << m_options.indent << "static const int " << name << "[] = {";
+    m_options.indent++;
+    for(size_t i = 0; i < values.size(); i++)
+    {
+        if(i % VALUES_PER_LINE == 0)
+            os << std::endl << m_options.indent;
+        else
+            os << ' ';
+
+        os << values[i];
+        if(i + 1 < values.size())
+            os << ',';
+    }
+    m_options.indent--;
+    os << std::endl << m_options.indent << (m_options.useConstexprTables ? "}};" : "};") << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TableGenerator::printTerminalSwitchTo(std::ostream & os) const
+{
+    m_switchOnTerminal.printBeginTo(os);
+    for(const auto & terminal : m_grammar.terminalsById)
+        os << m_options.indent << "case " << m_options.tokenPrefix << terminal.name << " : terminal = " << terminal.id << "; break;" << std::endl;
+    m_switchOnTerminal.printEndTo(os);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TableGenerator::printReduceActionTo(const Rule & reduceRule, std::ostream & os) const
+{
+    os << m_options.indent << "case " << reduceRule.numRule << " :" << std::endl;
+    m_options.indent++;
+    os << m_options.indent << '{' << std::endl;
+    m_options.indent++;
+
+    // Rule action code
+    os << m_options.indent << DriverGenerator::valueTypeName(m_options) << ' ' << Vars::RETURN << ';' << std::endl << std::endl;
+
+    if(reduceRule.action.find_first_of("\n\r") == std::string::npos)
+        os << m_options.indent;
+    os << reduceRule.action << std::endl << std::endl;
+
+    // Values & states stacks
+    os << m_options.indent << m_options.popValues.replaceParam(Vars::NB_VALUES, std::to_string(reduceRule.symbols.size()))  << std::endl;
+    os << m_options.indent << m_options.pushValue.replaceParam(Vars::VALUE,     Vars::RETURN)                       << std::endl;
+    os << m_options.indent << m_options.popState.replaceParam(Vars::NB_STATES, std::to_string(reduceRule.symbols.size())) << std::endl;
+
+    // Reduced intermediate
+    os << m_options.indent << m_options.intermediateName << " = " << reduceRule.intermediate.id << ';' << std::endl;
+    os << m_options.indent << "break;" << std::endl;
+
+    m_options.indent--;
+    os << m_options.indent << '}' << std::endl;
+    m_options.indent--;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int TableGenerator::encode(const ParsingAction & action)
+{
+    // Shift to state N is 'N + 1', reduce of rule N is '-N' (accept being the reduce of the start rule) and error is 0
+    switch(action.getType())
+    {
+        case ParsingAction::Type::SHIFT  : return action.getNextState() + 1;
+        case ParsingAction::Type::REDUCE : return -action.getNumRule();
+        case ParsingAction::Type::ACCEPT : return -1;
+        case ParsingAction::Type::ERROR  : return 0;
+    }
+
+    return 0;
+}
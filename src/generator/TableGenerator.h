@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef TABLE_GENERATOR_H
+#define TABLE_GENERATOR_H
+#include "core/ParseTable.h"
+#include "core/Grammar.h"
+#include "config/Options.h"
+#include "generator/CompressedTable.h"
+#include "generator/SwitchGenerator.h"
+#include "generator/FunctionGenerator.h"
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+// Table driven parse function : ACTION & GOTO tables are emitted compressed by row displacement,
+// and looked up by a generic driver. Only reduce actions (i.e. rules code) remain in a switch.
+class TableGenerator
+{
+    public :
+        TableGenerator(const ParseTable & table, size_t nbStates, const Grammar & grammar, Options & options);
+
+        void printTo(std::ostream & os) const;
+
+    private :
+        void printTableTo        (const std::string & name, const std::vector<int> & values, std::ostream & os) const;
+        void printTerminalSwitchTo(std::ostream & os) const;
+        void printReduceActionTo (const Rule & reduceRule, std::ostream & os) const;
+
+        static int encode(const ParsingAction & action);
+
+    private :
+        const ParseTable & m_table;
+        const Grammar &    m_grammar;
+        Options &          m_options;
+
+        CompressedTable    m_actions;
+        CompressedTable    m_gotos;
+        std::vector<int>   m_reducedRules;
+
+        FunctionGenerator  m_parseFunction;
+        SwitchGenerator    m_switchOnTerminal;
+        SwitchGenerator    m_switchOnRule;
+};
+
+#endif /* TABLE_GENERATOR_H */
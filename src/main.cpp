@@ -13,6 +13,8 @@
 #include "core/LR0/LR0Parser.h"
 #include "core/LR1/LR1Parser.h"
 #include "core/LALR1/LALR1Parser.h"
+#include "core/LALR1/LALR1DPParser.h"
+#include "core/PGM/PGMParser.h"
 #include "generator/ParserGenerator.h"
 #include "printer/PrettyPrinters.h"
 
@@ -20,6 +22,7 @@
 #include <iostream>
 #include <cstring>
 #include <memory>
+#include <stdexcept>
 
 ////////////////////////////////////////////////////////////////////////////////
 int main(int argc, char ** argv)
@@ -36,16 +39,12 @@ int main(int argc, char ** argv)
         return cmdLineOptions.errors.exitCode;
     }
 
-    // Open input & output file
+    // Open input (mapped in memory when possible) & output file
     Streams streams(cmdLineOptions.inputFileName, cmdLineOptions.outputFileName);
 
-    // Read input file
-    std::string inputBuffer;
-    inputBuffer.assign((std::istreambuf_iterator<char>(streams.inputStream())), std::istreambuf_iterator<char>());
-
     // Start parser
     Grammar     grammar;
-    LexerBNF    bnfLexer(inputBuffer, streams.outputStream());
+    LexerBNF    bnfLexer(streams.inputBuffer(), streams.outputStream());
     ParserBNF   bnfParser(bnfLexer, grammar);
 
     // Find each "bnf2c" block and parse it
@@ -56,6 +55,21 @@ int main(int argc, char ** argv)
     Options options = bnfParser.getInFileOptions();
     options << cmdLineOptions;
 
+    // Constexpr tables are compressed ones
+    if(options.useConstexprTables)
+        options.useCompressedTables = true;
+
+    // A computed goto parser goes through all tokens, so it reads the current one by itself
+    if(options.useComputedGotos && !options.useCompressedTables)
+        options.tokenName = options.currentToken;
+
+    // Tokens are pushed as any other value, unless a parser struct owns the stacks
+    options.pushToken = options.pushValue;
+    if(!options.parserStruct.empty())
+        DriverGenerator::setStacksCode(options);
+
+    grammar.setEndOfInput(options.endOfInputToken);
+
     // Check grammar
     grammar.check();
     if(!bnfParser.errors.list.empty() || !grammar.errors.list.empty())
@@ -65,6 +79,9 @@ int main(int argc, char ** argv)
         return 1;
     }
 
+    // Precompute FIRST sets used by lookaheads computation
+    grammar.computeFirstSets();
+
     // Replace pseudo variable
     grammar.replacePseudoVariables(options);
 
@@ -76,6 +93,10 @@ int main(int argc, char ** argv)
         parser = std::make_unique<LR1Parser>(grammar, options);
     else if(options.parserType == "LALR1")
         parser = std::make_unique<LALR1Parser>(grammar, options);
+    else if(options.parserType == "LALR1-DP")
+        parser = std::make_unique<LALR1DPParser>(grammar, options);
+    else if(options.parserType == "PGM")
+        parser = std::make_unique<PGMParser>(grammar, options);
     parser->generateStates();
     parser->check();
     if(!parser->errors.list.empty())
@@ -83,10 +104,20 @@ int main(int argc, char ** argv)
         std::cerr << parser->errors;
         return 1;
     }
+    parser->computeTable();
 
-    // Output generated code at the end of output file
-    ParserGenerator generator(*parser, grammar, options);
-    generator.printTo(streams.outputStream());
+    // Output generated code at the end of output file (a stale profile is rejected)
+    std::unique_ptr<ParserGenerator> generator;
+    try
+    {
+        generator = std::make_unique<ParserGenerator>(*parser, grammar, options);
+    }
+    catch(const std::runtime_error & error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    generator->printTo(streams.outputStream());
 
     // Debug output
     if(options.debugLevel != DebugLevel::NONE)
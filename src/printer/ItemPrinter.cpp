@@ -17,7 +17,7 @@ std::ostream & operator <<(std::ostream & os, const Item & item)
     else if(item.isShift())
         os << "[S" << (item.nextState != nullptr ? item.nextState->numState : -1) << "] ";
 
-    os << "<" << item.rule.name << "> ::=";
+    os << item.rule.intermediate << " ::=";
 
     // We need an iterator to compare to the dotted symbol
     for(auto symbolIt = item.rule.symbols.begin(); symbolIt != item.rule.symbols.end(); ++symbolIt)
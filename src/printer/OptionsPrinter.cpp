@@ -16,6 +16,7 @@ std::ostream & operator <<(std::ostream & os, const Options & options)
     DISPLAY_OPTION(stateType          );
     DISPLAY_OPTION(topState           );
     DISPLAY_OPTION(popState           );
+    DISPLAY_OPTION(pushState          );
     DISPLAY_OPTION(errorState         );
     DISPLAY_OPTION(acceptState        );
     DISPLAY_OPTION(valueType          );
@@ -29,6 +30,8 @@ std::ostream & operator <<(std::ostream & os, const Options & options)
     // Lexer options
     DISPLAY_OPTION(tokenType      );
     DISPLAY_OPTION(shiftToken     );
+    DISPLAY_OPTION(currentToken   );
+    DISPLAY_OPTION(lexerType      );
     DISPLAY_OPTION(tokenPrefix    );
     DISPLAY_OPTION(getTypeOfToken );
     DISPLAY_OPTION(endOfInputToken);
@@ -37,9 +40,16 @@ std::ostream & operator <<(std::ostream & os, const Options & options)
     DISPLAY_OPTION(intermediateType  );
     DISPLAY_OPTION(parseFunctionName );
     DISPLAY_OPTION(branchFunctionName);
+    DISPLAY_OPTION(parserStruct      );
+    DISPLAY_OPTION(instrumentFile    );
+    DISPLAY_OPTION(profileFile       );
 
     DISPLAY_OPTION(defaultSwitchStatement);
     DISPLAY_OPTION(useTableForBranches   );
+    DISPLAY_OPTION(useCompressedTables   );
+    DISPLAY_OPTION(useComputedGotos      );
+    DISPLAY_OPTION(useConstexprTables    );
+    DISPLAY_OPTION(fuseReduces           );
 
     DISPLAY_OPTION(tokenName       );
     DISPLAY_OPTION(intermediateName);
@@ -19,14 +19,13 @@
 #define CENTER(msg, maxSize)    std::setw((maxSize - ::strlen(msg)) / 2) << ' ' << msg << std::setw(maxSize - ((maxSize - ::strlen(msg)) / 2) - ::strlen(msg) - 1) << ' '
 
 ////////////////////////////////////////////////////////////////////////////////
-template<typename Container>
-std::string concatenateStrings(const Container & strings, const std::string & excluded = "", size_t minSize = 0)
+std::string concatenateStrings(const SymbolList & symbols, const std::string & excluded = "", size_t minSize = 0)
 {
     std::stringstream stream;
 
-    for(const std::string & name : strings)
-        if(name != excluded)
-            stream << std::setw(std::max(name.length(), minSize)) << std::left << name << '|';
+    for(const auto & symbol : symbols)
+        if(symbol.name != excluded)
+            stream << std::setw(std::max(symbol.name.length(), minSize)) << std::left << symbol.name << '|';
 
     return stream.str();
 }
@@ -34,20 +33,20 @@ std::string concatenateStrings(const Container & strings, const std::string & ex
 ////////////////////////////////////////////////////////////////////////////////
 void printStateActions(std::ostream & os, const ParsingAction & action, size_t padding)
 {
-    switch(action.type)
+    switch(action.getType())
     {
-        case ParsingAction::Type::SHIFT :  os << 'S' << std::setw(padding - 1) << std::left << (action.shiftNextState != nullptr ? action.shiftNextState->numState : -1) << '|'; break;
-        case ParsingAction::Type::REDUCE : os << 'R' << std::setw(padding - 1) << std::left << (action.reduceRule != nullptr ? action.reduceRule->numRule : -1) << '|'; break;
+        case ParsingAction::Type::SHIFT :  os << 'S' << std::setw(padding - 1) << std::left << action.getNextState() << '|'; break;
+        case ParsingAction::Type::REDUCE : os << 'R' << std::setw(padding - 1) << std::left << action.getNumRule() << '|'; break;
         case ParsingAction::Type::ACCEPT : os << std::setw(padding) << std::left << "ACC" << '|'; break;
         case ParsingAction::Type::ERROR :  os << std::setw(padding + 1) << std::right << '|'; break;
     };
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void printStateBranches(std::ostream & os, const ParserState * nextState, size_t padding)
+void printStateBranches(std::ostream & os, int nextState, size_t padding)
 {
-    if(nextState)
-        os << std::setw(padding) << std::left << nextState->numState << '|';
+    if(nextState != ParseTable::NO_STATE)
+        os << std::setw(padding) << std::left << nextState << '|';
     else
         os << std::setw(padding + 1) << std::right << '|';
 }
@@ -55,9 +54,9 @@ void printStateBranches(std::ostream & os, const ParserState * nextState, size_t
 ////////////////////////////////////////////////////////////////////////////////
 std::ostream & operator <<(std::ostream & os, const Parser & parser)
 {
-    // Header
-    std::string strTerminals = concatenateStrings(parser.getGrammar().terminals) + parser.getOptions().endOfInputToken + '|';
-    std::string strIntermediates = concatenateStrings(parser.getGrammar().intermediates, parser.getGrammar().START_RULE);
+    // Header, symbols in order of their ids (end of input being the last terminal)
+    std::string strTerminals = concatenateStrings(parser.getGrammar().terminalsById);
+    std::string strIntermediates = concatenateStrings(parser.getGrammar().intermediatesById, parser.getGrammar().START_RULE);
 
     os << "     |" << CENTER("Actions", std::max(strTerminals.length(), decltype(strTerminals.length())(7))) << '|';
     os <<             CENTER("Branchs", std::max(strIntermediates.length(), decltype(strIntermediates.length())(7))) << '|' << std::endl;
@@ -66,20 +65,19 @@ std::ostream & operator <<(std::ostream & os, const Parser & parser)
 
     // Table
     auto maxSizeIntermediate = std::to_string(parser.getStates().size()).length();
-    auto eoit = parser.getOptions().endOfInputToken;
+    const auto & table = parser.getTable();
     for(const auto & state : parser.getStates())
     {
         os << std::left << std::setw(5) << state->numState << '|';
 
         // Action
-        for(const auto & terminal : parser.getGrammar().terminals)
-            printStateActions(os, state->getAction(terminal, eoit), terminal.length());
-        printStateActions(os, state->getAction(eoit, eoit), eoit.length());
+        for(const auto & terminal : parser.getGrammar().terminalsById)
+            printStateActions(os, table.getAction(state->numState, terminal), terminal.name.length());
 
         // Goto
-        for(const auto & intermediate : parser.getGrammar().intermediates)
-            if(intermediate != parser.getGrammar().START_RULE)
-                printStateBranches(os, state->getGoto(intermediate), std::max(intermediate.length(), maxSizeIntermediate));
+        for(const auto & intermediate : parser.getGrammar().intermediatesById)
+            if(intermediate.name != parser.getGrammar().START_RULE)
+                printStateBranches(os, table.getGoto(state->numState, intermediate), std::max(intermediate.name.length(), maxSizeIntermediate));
 
         os << std::endl;
     }
@@ -10,5 +10,5 @@
 ////////////////////////////////////////////////////////////////////////////////
 std::ostream & operator <<(std::ostream & os, const Rule & rule)
 {
-    return os << "<" << rule.name << "> ::= " << separate_elems(rule.symbols, " ");
+    return os << rule.intermediate << " ::= " << separate_elems(rule.symbols, " ");
 }
@@ -7,6 +7,7 @@
 #ifndef ALGOS_H
 #define ALGOS_H
 #include <utility>
+#include <cstddef>
 
 // Utilities algorithm
 template<typename InputIterator, typename Func>
@@ -19,32 +20,10 @@ void for_each(const std::pair<InputIterator, InputIterator> & range, Func func)
         func(*first++);
 }
 
-template<typename Container1, typename Container2, typename Func>
-void for_each_pair(Container1 c1, Container2 c2, Func func)
+// Mix a value into an existing hash (same recipe as boost::hash_combine)
+inline std::size_t hash_combine(std::size_t seed, std::size_t value)
 {
-    auto first1 = std::begin(c1);
-    auto last1 = std::end(c1);
-    auto first2 = std::begin(c2);
-    auto last2 = std::end(c2);
-
-    while(first1 != last1 && first2 != last2)
-        func(*first1++, *first2++);
-}
-
-template<typename Container1, typename Container2, typename Predicate>
-bool all_of_pairs(Container1 c1, Container2 c2, Predicate pred)
-{
-    auto first1 = std::begin(c1);
-    auto last1 = std::end(c1);
-    auto first2 = std::begin(c2);
-    auto last2 = std::end(c2);
-
-    while(first1 != last1 && first2 != last2)
-    {
-        if(!pred(*first1++, *first2++))
-            return false;
-    }
-    return true;
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
 }
 
 #endif /* ALGOS_H */
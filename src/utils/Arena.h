@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef ARENA_H
+#define ARENA_H
+#include <memory>
+#include <vector>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+
+// Bump allocator : memory is only released all at once, when the arena is destroyed.
+// Objects created into the arena still need their destructor to be called (see Deleter).
+class Arena
+{
+    public :
+        static const size_t BLOCK_SIZE = 64 * 1024;
+
+        struct Deleter
+        {
+            template<typename T>
+            void operator()(T * object) const { object->~T(); }
+        };
+
+    public :
+        Arena(void) = default;
+        Arena(const Arena &) = delete;
+        Arena & operator =(const Arena &) = delete;
+
+        void * allocate(size_t size, size_t alignment)
+        {
+            size_t padding = (alignment - reinterpret_cast<std::uintptr_t>(m_current) % alignment) % alignment;
+            if(m_current == nullptr || padding + size > m_remaining)
+            {
+                // Big chunks get their own block, so that the current one isn't wasted
+                if(size + alignment > BLOCK_SIZE / 4)
+                {
+                    m_blocks.emplace_back(new char[size + alignment]);
+                    return alignPointer(m_blocks.back().get(), alignment);
+                }
+
+                m_blocks.emplace_back(new char[BLOCK_SIZE]);
+                m_current   = m_blocks.back().get();
+                m_remaining = BLOCK_SIZE;
+                padding     = (alignment - reinterpret_cast<std::uintptr_t>(m_current) % alignment) % alignment;
+            }
+
+            void * memory = m_current + padding;
+            m_current   += padding + size;
+            m_remaining -= padding + size;
+            return memory;
+        }
+
+        template<typename T, typename ... Args>
+        std::unique_ptr<T, Deleter> create(Args && ... args)
+        {
+            return std::unique_ptr<T, Deleter>(new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...));
+        }
+
+        void reset(void)
+        {
+            m_blocks.clear();
+            m_current   = nullptr;
+            m_remaining = 0;
+        }
+
+        size_t getNbBlocks(void) const { return m_blocks.size(); }
+
+    private :
+        static void * alignPointer(char * memory, size_t alignment)
+        {
+            return memory + (alignment - reinterpret_cast<std::uintptr_t>(memory) % alignment) % alignment;
+        }
+
+        std::vector<std::unique_ptr<char[]>> m_blocks;
+        char *                               m_current   = nullptr;
+        size_t                               m_remaining = 0;
+};
+
+// Standard allocator drawing from an arena, deallocation does nothing
+template<typename T>
+class ArenaAllocator
+{
+    public :
+        using value_type = T;
+
+        // Containers take the allocator along with the content of another one
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap            = std::true_type;
+
+        template<typename U>
+        struct rebind { using other = ArenaAllocator<U>; };
+
+    public :
+        ArenaAllocator(Arena & arena) : arena(&arena) {}
+
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U> & allocator) : arena(allocator.arena) {}
+
+        T *  allocate(size_t nbObjects)    { return static_cast<T *>(arena->allocate(nbObjects * sizeof(T), alignof(T))); }
+        void deallocate(T *, size_t)       { /* Released with the arena */ }
+
+        template<typename U>
+        bool operator ==(const ArenaAllocator<U> & allocator) const { return arena == allocator.arena; }
+        template<typename U>
+        bool operator !=(const ArenaAllocator<U> & allocator) const { return arena != allocator.arena; }
+
+    public :
+        Arena * arena;
+};
+
+#endif /* ARENA_H */
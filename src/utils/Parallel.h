@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef PARALLEL_H
+#define PARALLEL_H
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+// Upper bound of workers, each of them owning a workspace
+const size_t MAX_WORKERS = 256;
+
+// Number of workers to use when 'nbJobs' are requested (0 : one per processor)
+inline size_t nb_workers(size_t nbJobs)
+{
+    if(nbJobs == 0)
+        nbJobs = std::thread::hardware_concurrency();
+
+    return std::min<size_t>(std::max<size_t>(nbJobs, 1), MAX_WORKERS);
+}
+
+// Call 'func(numWorker, i)' for each 'i' in [0, count[ on up to 'nbWorkers' threads.
+// Indices are handed out one at a time, as their cost may vary a lot.
+template<typename Func>
+void parallel_for(size_t nbWorkers, size_t count, Func func)
+{
+    nbWorkers = std::min(nbWorkers, count);
+    if(nbWorkers <= 1)
+    {
+        for(size_t i = 0; i < count; i++)
+            func(0, i);
+
+        return;
+    }
+
+    std::atomic<size_t> nextIndex(0);
+    auto work = [&](size_t numWorker)
+    {
+        for(size_t i = nextIndex++; i < count; i = nextIndex++)
+            func(numWorker, i);
+    };
+
+    std::vector<std::thread> threads;
+    for(size_t numWorker = 1; numWorker < nbWorkers; numWorker++)
+        threads.emplace_back(work, numWorker);
+
+    work(0);
+
+    for(auto & thread : threads)
+        thread.join();
+}
+
+#endif /* PARALLEL_H */
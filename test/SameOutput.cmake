@@ -0,0 +1,78 @@
+################################################################################
+#                                     BNF2C
+#
+# This file is distributed under the 4-clause Berkeley Software Distribution
+# License. See LICENSE for details.
+################################################################################
+# Generates a parser with one job from its (memory mapped) source, then again with
+# several jobs or reading its source otherwise, and checks both outputs are the same :
+#   cmake -DBNF2C=<bnf2c> -DINPUT=<source> -DOUTPUT=<name> [-DOPTIONS=<bnf2c options>] [-DJOBS=<n>]
+#         [-DREAD_FROM=<file|stdin|pages>] -P SameOutput.cmake
+# The source is read from the standard input with "stdin", and from a copy filling
+# whole pages with "pages" (such a file can't be mapped with a nul terminator).
+separate_arguments(OPTIONS UNIX_COMMAND "${OPTIONS}")
+if(NOT JOBS)
+    set(JOBS 1)
+endif()
+
+function(generate output input read_from)
+    if(read_from STREQUAL "stdin")
+        execute_process(
+            COMMAND ${BNF2C} ${OPTIONS} ${ARGN} -o ${output}
+            INPUT_FILE ${input}
+            RESULT_VARIABLE RESULT
+        )
+    else()
+        execute_process(
+            COMMAND ${BNF2C} ${OPTIONS} ${ARGN} -o ${output} ${input}
+            RESULT_VARIABLE RESULT
+        )
+    endif()
+    if(NOT RESULT EQUAL 0)
+        message(FATAL_ERROR "Unable to generate ${output}")
+    endif()
+endfunction(generate)
+
+# Spaces ending the last bnf2c block fill the copy up to a multiple of 64 KiB,
+# leaving the output unchanged
+function(fill_pages input output)
+    file(READ ${input} SOURCE)
+    string(FIND "${SOURCE}" "/*!bnf2c" BLOCK_BEGIN REVERSE)
+    string(SUBSTRING "${SOURCE}" ${BLOCK_BEGIN} -1 BLOCK)
+    string(FIND "${BLOCK}" "*/" BLOCK_END)
+    math(EXPR BLOCK_END "${BLOCK_BEGIN} + ${BLOCK_END}")
+    string(SUBSTRING "${SOURCE}" 0 ${BLOCK_END} HEAD)
+    string(SUBSTRING "${SOURCE}" ${BLOCK_END} -1 TAIL)
+
+    string(LENGTH "${SOURCE}" LENGTH)
+    math(EXPR NB_SPACES "65536 - ${LENGTH} % 65536")
+    set(SPACES " ")
+    set(PADDING "")
+    while(NB_SPACES GREATER 0)
+        math(EXPR BIT "${NB_SPACES} % 2")
+        if(BIT)
+            set(PADDING "${PADDING}${SPACES}")
+        endif()
+        set(SPACES "${SPACES}${SPACES}")
+        math(EXPR NB_SPACES "${NB_SPACES} / 2")
+    endwhile()
+
+    file(WRITE ${output} "${HEAD}${PADDING}${TAIL}")
+endfunction(fill_pages)
+
+generate(${OUTPUT}.expected.c ${INPUT} file -J 1)
+
+if(READ_FROM STREQUAL "pages")
+    fill_pages(${INPUT} ${OUTPUT}.pages)
+    generate(${OUTPUT}.c ${OUTPUT}.pages file -J ${JOBS})
+else()
+    generate(${OUTPUT}.c ${INPUT} "${READ_FROM}" -J ${JOBS})
+endif()
+
+execute_process(
+    COMMAND ${CMAKE_COMMAND} -E compare_files ${OUTPUT}.expected.c ${OUTPUT}.c
+    RESULT_VARIABLE RESULT
+)
+if(NOT RESULT EQUAL 0)
+    message(FATAL_ERROR "${OUTPUT}.c differs from ${OUTPUT}.expected.c")
+endif()
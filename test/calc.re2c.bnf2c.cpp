@@ -15,6 +15,7 @@ namespace calc {
    bnf2c:parser:pop-state             = "for(int i=0; i<<NB_STATES>; i++) calc::stateStack.pop();"
    bnf2c:parser:error-state           = "STATE_ERROR"
    bnf2c:parser:accept-state          = "STATE_ACCEPT"
+   bnf2c:parser:push-state            = "calc::stateStack.push(<STATE>);"
 
    bnf2c:parser:value-type            = "calc::Value"
    bnf2c:parser:push-value            = "calc::push_value(calc::Value(<VALUE>));"
@@ -25,6 +26,7 @@ namespace calc {
 
    bnf2c:lexer:token-type             = "calc::Token"
    bnf2c:lexer:shift-token            = "nextToken();"
+   bnf2c:lexer:current-token          = "calc::token"
    bnf2c:lexer:token-prefix           = "calc::"
    bnf2c:lexer:get-type-of-token      = "<TOKEN>.type"
    bnf2c:lexer:end-of-input-token     = "EOI"
@@ -69,7 +71,11 @@ union Value
     Value(const Token & token) : token(token) { }
 };
 
+#ifdef CALC_COMPUTED_GOTO
+int parseFunction(void);
+#else
 int parseFunction(Token);
+#endif
 
 #define STATE_ERROR  -5
 #define STATE_ACCEPT -6
@@ -160,17 +166,35 @@ void nextToken(void)
       | <E> SUB  <E> { $$ = $1 - $3;     }
 */
 
-TEST(Calc, AddSubMultiplyDivide)
+// Parse an expression, returning the final state
+int parse(const char * expression)
 {
-    calc::input = "1+0+1*3+50/2+9+1+1-10";
+    calc::input = expression;
+    calc::stateStack = std::stack<int>();
+    calc::valueStack.clear();
 
     calc::nextToken();
     calc::stateStack.push(0);
+#ifdef CALC_COMPUTED_GOTO
+    // Computed gotos parser only returns once the whole input is parsed
+    calc::stateStack.push(calc::parseFunction());
+#else
     while((calc::stateStack.top() != STATE_ERROR) && (calc::stateStack.top() != STATE_ACCEPT))
         calc::stateStack.push(calc::parseFunction(calc::token));
+#endif
+
+    return calc::stateStack.top();
+}
 
-    EXPECT_EQ(STATE_ACCEPT, calc::stateStack.top()) << "An error has occured while parsing expression";
+TEST(Calc, AddSubMultiplyDivide)
+{
+    EXPECT_EQ(STATE_ACCEPT, calc::parse("1+0+1*3+50/2+9+1+1-10")) << "An error has occured while parsing expression";
     EXPECT_EQ(20, calc::valueStack.back().value);
 }
 
+TEST(Calc, SyntaxError)
+{
+    EXPECT_EQ(STATE_ERROR, calc::parse("1+2*/3")) << "An invalid expression has been accepted";
+}
+
 } /* Namespace calc */
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#include <cstdlib>
+#include <array> // Constexpr tables
+
+// Small stacks, so that nested expressions overflow them
+#define CALCPARSER_MAX_DEPTH 64
+
+/*!bnf2c
+   bnf2c:parser:error-state           = "STATE_ERROR"
+   bnf2c:parser:accept-state          = "STATE_ACCEPT"
+
+   bnf2c:parser:value-type            = "Value"
+   bnf2c:parser:value-as-token        = "<VALUE>.token"
+   bnf2c:parser:value-as-intermediate = "<VALUE>.<TYPE>"
+
+   bnf2c:lexer:token-type             = "Token"
+   bnf2c:lexer:shift-token            = "lexer->next();"
+   bnf2c:lexer:current-token          = "lexer->token"
+   bnf2c:lexer:lexer-type             = "Lexer"
+   bnf2c:lexer:get-type-of-token      = "<TOKEN>.type"
+   bnf2c:lexer:end-of-input-token     = "EOI"
+
+   bnf2c:output:parser-struct         = "CalcParser"
+
+   bnf2c:generator:default-switch     = "true"
+
+   bnf2c:type<value> E T F START
+*/
+
+#define STATE_ERROR  -5
+#define STATE_ACCEPT -6
+
+enum T_TOKEN {
+    MULT,
+    DIV,
+    ADD,
+    SUB,
+    LPAR,
+    RPAR,
+    NUMBER,
+    EOI,
+    ERROR
+};
+
+struct Token
+{
+    T_TOKEN       type;
+    const char *  start;
+
+    long long number(void) const { return ::atoll(start); }
+};
+
+union Value
+{
+    long long value;
+    Token     token;
+};
+
+struct Lexer
+{
+    const char * input;
+    Token        token;
+
+    void next(void)
+    {
+        while(*input == ' ')
+            input++;
+
+        token.start = input;
+        switch(*input)
+        {
+            case '*'  : input++; token.type = MULT;  break;
+            case '/'  : input++; token.type = DIV;   break;
+            case '+'  : input++; token.type = ADD;   break;
+            case '-'  : input++; token.type = SUB;   break;
+            case '('  : input++; token.type = LPAR;  break;
+            case ')'  : input++; token.type = RPAR;  break;
+            case '\0' :          token.type = EOI;   break;
+            default :
+                if((*input < '0') || (*input > '9'))
+                {
+                    input++;
+                    token.type = ERROR;
+                    break;
+                }
+
+                while((*input >= '0') && (*input <= '9'))
+                    input++;
+                token.type = NUMBER;
+                break;
+        }
+    }
+};
+
+/*!bnf2c
+<START> ::= <E>
+
+<E> ::= <E> ADD <T>       { $$ = $1 + $3; }
+      | <E> SUB <T>       { $$ = $1 - $3; }
+      | <T>
+
+<T> ::= <T> MULT <F>      { $$ = $1 * $3; }
+      | <T> DIV  <F>      { $$ = $1 / $3; }
+      | <F>
+
+<F> ::= NUMBER            { $$ = $1.number(); }
+      | LPAR <E> RPAR     { $$ = $2; }
+*/
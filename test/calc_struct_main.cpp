@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+// Parser struct generated with loops, computed gotos or constexpr tables, depending on the test
+#include CALC_STRUCT_HEADER
+#include "gtest/gtest.h"
+#include <string>
+
+#ifdef CALC_STRUCT_TEMPLATE
+// Parser with constexpr tables is a template, defaulting to the user types
+static CalcParser<> parser;
+#else
+static CalcParser parser;
+#endif
+
+int parse(const std::string & expression)
+{
+    Lexer lexer;
+    lexer.input = expression.c_str();
+    lexer.next();
+
+    return parser.parse(lexer);
+}
+
+std::string nested(int depth)
+{
+    return std::string(depth, '(') + "1" + std::string(depth, ')');
+}
+
+TEST(CalcStruct, Precedence)
+{
+    EXPECT_EQ(STATE_ACCEPT, parse("1+2*3-(4-1)*2")) << "An error has occured while parsing expression";
+    EXPECT_EQ(1, parser.valueStack[parser.nbValues - 1].value);
+}
+
+TEST(CalcStruct, SyntaxError)
+{
+    EXPECT_EQ(STATE_ERROR, parse("1+*2")) << "An invalid expression has been accepted";
+}
+
+TEST(CalcStruct, StackOverflow)
+{
+    EXPECT_EQ(STATE_ACCEPT, parse(nested(CALCPARSER_MAX_DEPTH / 2))) << "An error has occured while parsing expression";
+    EXPECT_EQ(1, parser.valueStack[parser.nbValues - 1].value);
+
+    // Too deep for the stacks, the parser stops on an error
+    EXPECT_EQ(STATE_ERROR, parse(nested(CALCPARSER_MAX_DEPTH)));
+    EXPECT_LE(parser.nbStates, CALCPARSER_MAX_DEPTH);
+}
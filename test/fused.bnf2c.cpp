@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#include "gtest/gtest.h"
+#include <stack>
+#include <deque>
+#include <cstdlib>
+
+// After "( NUMBER", reduces on RPAR are fused : <F> ::= NUMBER, then the unit
+// copy <E> ::= <T> (<T> ::= <F> being bypassed by the parse tables)
+namespace fused {
+/*!bnf2c
+   bnf2c:parser:top-state             = "fused::stateStack.top()"
+   bnf2c:parser:pop-state             = "for(int i=0; i<<NB_STATES>; i++) fused::stateStack.pop();"
+   bnf2c:parser:error-state           = "STATE_ERROR"
+   bnf2c:parser:accept-state          = "STATE_ACCEPT"
+
+   bnf2c:parser:value-type            = "fused::Value"
+   bnf2c:parser:push-value            = "fused::valueStack.push_back(fused::Value(<VALUE>));"
+   bnf2c:parser:pop-values            = "fused::valueStack.resize(fused::valueStack.size() - <NB_VALUES>);"
+   bnf2c:parser:get-value             = "fused::valueStack[fused::valueStack.size() - <VALUE_IDX> - 1]"
+   bnf2c:parser:value-as-token        = "<VALUE>.token"
+   bnf2c:parser:value-as-intermediate = "<VALUE>.<TYPE>"
+
+   bnf2c:lexer:token-type             = "fused::Token"
+   bnf2c:lexer:shift-token            = "nextToken();"
+   bnf2c:lexer:token-prefix           = "fused::"
+   bnf2c:lexer:get-type-of-token      = "<TOKEN>.type"
+   bnf2c:lexer:end-of-input-token     = "EOI"
+
+   bnf2c:output:parse-function        = "fused::parseFunction"
+   bnf2c:output:branch-function       = "branchFunction"
+
+   bnf2c:generator:default-switch     = "true"
+
+   bnf2c:type<value> P E T F X START
+*/
+
+typedef enum {
+    MULT,
+    ADD,
+    SUB,
+    DIV,
+    LPAR,
+    RPAR,
+    NUMBER,
+    EOI,
+    ERROR
+} T_TOKEN;
+
+struct Token
+{
+    T_TOKEN       type;
+    const char *  start;
+
+    long long number(void) const { return ::atoll(start); }
+};
+
+union Value
+{
+    long long   value;
+    Token       token;
+
+    Value(void) { }
+    Value(const Token & token) : token(token) { }
+};
+
+int parseFunction(Token);
+
+#define STATE_ERROR  -5
+#define STATE_ACCEPT -6
+
+std::stack<int>     stateStack;
+std::deque<Value>   valueStack;
+
+const char * input;
+
+Token token;
+
+void nextToken(void)
+{
+    token.start = input;
+    switch(*input)
+    {
+        case '*'  : input++; token.type = MULT; break;
+        case '+'  : input++; token.type = ADD;  break;
+        case '-'  : input++; token.type = SUB;  break;
+        case '/'  : input++; token.type = DIV;  break;
+        case '('  : input++; token.type = LPAR; break;
+        case ')'  : input++; token.type = RPAR; break;
+        case '\0' :          token.type = EOI;  break;
+        default :
+            if((*input < '0') || (*input > '9'))
+            {
+                input++;
+                token.type = ERROR;
+                break;
+            }
+
+            while((*input >= '0') && (*input <= '9'))
+                input++;
+            token.type = NUMBER;
+            break;
+    }
+}
+
+/*!bnf2c
+<START> ::= <P>
+
+<P> ::= LPAR <E> RPAR     { $$ = $2;  }
+      | LPAR <X> ADD      { $$ = $2;  }
+      | LPAR <X> SUB      { $$ = $2;  }
+      | LPAR <X> DIV      { $$ = $2;  }
+
+<E> ::= <T>
+
+<T> ::= <T> MULT <F>      { $$ = $1 * $3; }
+      | <F>
+
+<F> ::= NUMBER            { $$ = $1.number();  }
+
+<X> ::= NUMBER            { $$ = -$1.number(); }
+*/
+
+// Parse an expression, returning the final state
+int parse(const char * expression)
+{
+    fused::input = expression;
+    fused::stateStack = std::stack<int>();
+    fused::valueStack.clear();
+
+    fused::nextToken();
+    fused::stateStack.push(0);
+    while((fused::stateStack.top() != STATE_ERROR) && (fused::stateStack.top() != STATE_ACCEPT))
+        fused::stateStack.push(fused::parseFunction(fused::token));
+
+    return fused::stateStack.top();
+}
+
+TEST(Fused, UnitCopyInChain)
+{
+    EXPECT_EQ(STATE_ACCEPT, fused::parse("(7)")) << "An error has occured while parsing expression";
+    ASSERT_EQ(1u, fused::valueStack.size());
+    EXPECT_EQ(7, fused::valueStack.back().value);
+}
+
+TEST(Fused, Product)
+{
+    EXPECT_EQ(STATE_ACCEPT, fused::parse("(2*3*4)")) << "An error has occured while parsing expression";
+    ASSERT_EQ(1u, fused::valueStack.size());
+    EXPECT_EQ(24, fused::valueStack.back().value);
+}
+
+TEST(Fused, OtherReduce)
+{
+    EXPECT_EQ(STATE_ACCEPT, fused::parse("(5+")) << "An error has occured while parsing expression";
+    ASSERT_EQ(1u, fused::valueStack.size());
+    EXPECT_EQ(-5, fused::valueStack.back().value);
+}
+
+} /* Namespace fused */
@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#include "core/LR1/LR1State.h"
+#include "core/Grammar.h"
+#include "gtest/gtest.h"
+
+// <e> ::= E and <f> ::= E, reduced in the same state
+struct ParserStateCheck : public ::testing::Test
+{
+    Grammar grammar;
+    Rule    ruleE;
+    Rule    ruleF;
+    Arena   arena;
+
+    void SetUp(void) override
+    {
+        grammar.addIntermediate(Grammar::START_RULE);
+        grammar.addTerminal("C");
+        grammar.addTerminal("D");
+        const Symbol E = grammar.addTerminal("E");
+        grammar.setEndOfInput("EOI");
+
+        Rule startRule(grammar.intermediates.at(Grammar::START_RULE));
+        startRule.addSymbol(grammar.addIntermediate("e"));
+        grammar.addRule(startRule);
+
+        ruleE = Rule(grammar.intermediates.at("e"));
+        ruleE.addSymbol(E);
+        grammar.addRule(ruleE);
+
+        ruleF = Rule(grammar.addIntermediate("f"));
+        ruleF.addSymbol(E);
+        grammar.addRule(ruleF);
+    }
+
+    TerminalSet lookaheads(const std::vector<std::string> & names) const
+    {
+        TerminalSet terminals(grammar.terminalsById);
+        for(const auto & name : names)
+            terminals.insert(grammar.terminals.at(name));
+
+        return terminals;
+    }
+
+    size_t check(TerminalSet && lookaheadsE, TerminalSet && lookaheadsF)
+    {
+        LR1State state(arena);
+        state.addItem(ruleE, ruleE.symbols.end(), std::move(lookaheadsE));
+        state.addItem(ruleF, ruleF.symbols.end(), std::move(lookaheadsF));
+
+        Errors<GeneratingError> errors;
+        state.check(errors);
+
+        return errors.list.size();
+    }
+};
+
+TEST_F(ParserStateCheck, DisjointLookaheadsAreAccepted)
+{
+    EXPECT_EQ(0u, check(lookaheads({ "C" }), lookaheads({ "D" })));
+}
+
+TEST_F(ParserStateCheck, SharedLookaheadIsRejected)
+{
+    EXPECT_EQ(1u, check(lookaheads({ "C", "D" }), lookaheads({ "D" })));
+}
+
+TEST_F(ParserStateCheck, NoLookaheadIsRejected)
+{
+    // An item without lookaheads (LR0) is reduced on any terminal
+    EXPECT_EQ(1u, check(TerminalSet(grammar.terminalsById), lookaheads({ "D" })));
+}
@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////////////
+//                                    BNF2C
+//
+// This file is distributed under the 4-clause Berkeley Software Distribution
+// License. See LICENSE for details.
+////////////////////////////////////////////////////////////////////////////////
+#include "core/TerminalSet.h"
+#include "gtest/gtest.h"
+
+// Terminals spread over inline & heap words
+struct TerminalSetInsert : public ::testing::Test
+{
+    SymbolList terminals;
+
+    void SetUp(void) override
+    {
+        for(int id = 0; id < 300; id++)
+            terminals.push_back(Symbol { Symbol::Type::TERMINAL, id, "T" + std::to_string(id) });
+    }
+};
+
+TEST_F(TerminalSetInsert, IntoTerminalsList)
+{
+    TerminalSet set(terminals);
+    EXPECT_TRUE(set.insert(terminals[3]));
+    EXPECT_TRUE(set.insert(terminals[299]));
+    EXPECT_FALSE(set.insert(terminals[299]));
+
+    EXPECT_EQ(2u, set.size());
+    EXPECT_EQ(299, std::next(set.begin())->id);
+}
+
+TEST_F(TerminalSetInsert, IntoEmptySet)
+{
+    // The set grows past its inline words
+    TerminalSet set;
+    EXPECT_TRUE(set.insert(terminals[70]));
+    EXPECT_TRUE(set.insert(terminals[299]));
+    EXPECT_FALSE(set.insert(terminals[70]));
+
+    EXPECT_EQ(2u, set.size());
+    EXPECT_TRUE(set.contains(terminals[70]));
+    EXPECT_TRUE(set.contains(terminals[299]));
+    EXPECT_FALSE(set.contains(terminals[71]));
+}
+
+TEST_F(TerminalSetInsert, EmptySetEqualsTerminalsList)
+{
+    TerminalSet emptySet;
+    TerminalSet listSet(terminals);
+    emptySet.insert(terminals[42]);
+    listSet.insert(terminals[42]);
+
+    EXPECT_EQ(listSet, emptySet);
+    EXPECT_EQ(listSet.hash(), emptySet.hash());
+}